@@ -105,6 +105,9 @@ HEADERS += \
     src/exporter.h \
     src/exporterfactory.h \
     src/exportformat.h \
+    src/fenwicktree.h \
+    src/htmlblock.h \
+    src/htmlblockobserver.h \
     src/htmlpreview.h \
     src/localedialog.h \
     src/mainwindow.h \
@@ -120,11 +123,14 @@ HEADERS += \
     src/outlinewidget.h \
     src/preferencesdialog.h \
     src/previewoptionsdialog.h \
+    src/previewschemehandler.h \
     src/sandboxedwebpage.h \
     src/sessionstatistics.h \
     src/sessionstatisticswidget.h \
+    src/sentencesegmenter.h \
     src/sidebar.h \
     src/simplefontdialog.h \
+    src/statisticssnapshot.h \
     src/stringobserver.h \
     src/stylesheetbuilder.h \
     src/textblockdata.h \
@@ -133,13 +139,17 @@ HEADERS += \
     src/themerepository.h \
     src/themeselectiondialog.h \
     src/timelabel.h \
+    src/wordsegmenter.h \
     src/findreplace.h \
     src/color_button.h \
     src/spelling/abstract_dictionary.h \
     src/spelling/abstract_dictionary_provider.h \
+    src/spelling/bk_tree.h \
     src/spelling/dictionary_manager.h \
     src/spelling/dictionary_ref.h \
-    src/spelling/spell_checker.h
+    src/spelling/language_detector.h \
+    src/spelling/spell_checker.h \
+    src/spelling/verdict_cache.h
 
 SOURCES += \
     src/abstractstatisticswidget.cpp \
@@ -157,6 +167,7 @@ SOURCES += \
     src/exporter.cpp \
     src/exporterfactory.cpp \
     src/exportformat.cpp \
+    src/htmlblockobserver.cpp \
     src/htmlpreview.cpp \
     src/localedialog.cpp \
     src/mainwindow.cpp \
@@ -170,9 +181,11 @@ SOURCES += \
     src/outlinewidget.cpp \
     src/preferencesdialog.cpp \
     src/previewoptionsdialog.cpp \
+    src/previewschemehandler.cpp \
     src/sandboxedwebpage.cpp \
     src/sessionstatistics.cpp \
     src/sessionstatisticswidget.cpp \
+    src/sentencesegmenter.cpp \
     src/sidebar.cpp \
     src/simplefontdialog.cpp \
     src/stringobserver.cpp \
@@ -182,10 +195,14 @@ SOURCES += \
     src/themerepository.cpp \
     src/themeselectiondialog.cpp \
     src/timelabel.cpp \
+    src/wordsegmenter.cpp \
     src/color_button.cpp \
     src/findreplace.cpp \
+    src/spelling/bk_tree.cpp \
     src/spelling/dictionary_manager.cpp \
-    src/spelling/spell_checker.cpp
+    src/spelling/language_detector.cpp \
+    src/spelling/spell_checker.cpp \
+    src/spelling/verdict_cache.cpp
 
 # Generate translations
 TRANSLATIONS = $$files(translations/ghostwriter_*.ts)
@@ -26,6 +26,7 @@
 
 #include "mainwindow.h"
 #include "appsettings.h"
+#include "previewschemehandler.h"
 
 int main(int argc, char *argv[])
 {
@@ -34,6 +35,9 @@ int main(int argc, char *argv[])
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
 #endif
 
+    // Custom URL schemes have to be known before the web engine starts.
+    ghostwriter::PreviewSchemeHandler::registerScheme();
+
     QApplication app(argc, argv);
     
 #if defined(Q_OS_WIN)
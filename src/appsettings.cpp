@@ -57,6 +57,9 @@
 #define GW_DICTIONARY_KEY "Spelling/locale"
 #define GW_LOCALE_KEY "Application/locale"
 #define GW_LIVE_SPELL_CHECK_KEY "Spelling/liveSpellCheck"
+#define GW_DETECT_LANGUAGE_KEY "Spelling/detectLanguage"
+#define GW_DICTIONARY_IDLE_TIMEOUT_KEY "Spelling/dictionaryIdleTimeout"
+#define GW_DICTIONARY_MEMORY_BUDGET_KEY "Spelling/dictionaryMemoryBudget"
 #define GW_SIDEBAR_OPEN_KEY "Window/sidebarOpen"
 #define GW_HTML_PREVIEW_OPEN_KEY "Preview/htmlPreviewOpen"
 #define GW_LAST_USED_EXPORTER_KEY "Preview/lastUsedExporter"
@@ -90,6 +93,9 @@ public:
     bool insertSpacesForTabsEnabled;
     bool largeHeadingSizesEnabled;
     bool liveSpellCheckEnabled;
+    bool languageDetectionEnabled;
+    int dictionaryIdleTimeout;
+    int dictionaryMemoryBudget;
     bool useUnderlineForEmphasis;
     EditorWidth editorWidth;
     Exporter *currentHtmlExporter;
@@ -137,6 +143,9 @@ void AppSettings::store()
     appSettings.setValue(GW_BACKUP_FILE_KEY, QVariant(d->backupFileEnabled));
     appSettings.setValue(GW_BULLET_CYCLING_KEY, QVariant(d->bulletPointCyclingEnabled));
     appSettings.setValue(GW_DICTIONARY_KEY, QVariant(d->dictionaryLanguage));
+    appSettings.setValue(GW_DETECT_LANGUAGE_KEY, QVariant(d->languageDetectionEnabled));
+    appSettings.setValue(GW_DICTIONARY_IDLE_TIMEOUT_KEY, QVariant(d->dictionaryIdleTimeout));
+    appSettings.setValue(GW_DICTIONARY_MEMORY_BUDGET_KEY, QVariant(d->dictionaryMemoryBudget));
     appSettings.setValue(GW_DISPLAY_TIME_IN_FULL_SCREEN_KEY, QVariant(d->displayTimeInFullScreenEnabled));
     appSettings.setValue(GW_EDITOR_WIDTH_KEY, QVariant(d->editorWidth));
     appSettings.setValue(GW_FOCUS_MODE_KEY, QVariant(d->focusMode));
@@ -488,6 +497,51 @@ void AppSettings::setLiveSpellCheckEnabled(bool enabled)
     emit liveSpellCheckChanged(enabled);
 }
 
+bool AppSettings::languageDetectionEnabled() const
+{
+    Q_D(const AppSettings);
+    
+    return d->languageDetectionEnabled;
+}
+
+void AppSettings::setLanguageDetectionEnabled(bool enabled)
+{
+    Q_D(AppSettings);
+    
+    d->languageDetectionEnabled = enabled;
+    DictionaryManager::instance().setDetectLanguage(enabled);
+}
+
+int AppSettings::dictionaryIdleTimeout() const
+{
+    Q_D(const AppSettings);
+    
+    return d->dictionaryIdleTimeout;
+}
+
+void AppSettings::setDictionaryIdleTimeout(int minutes)
+{
+    Q_D(AppSettings);
+    
+    d->dictionaryIdleTimeout = minutes;
+    DictionaryManager::instance().setEvictionPolicy(d->dictionaryIdleTimeout, d->dictionaryMemoryBudget);
+}
+
+int AppSettings::dictionaryMemoryBudget() const
+{
+    Q_D(const AppSettings);
+    
+    return d->dictionaryMemoryBudget;
+}
+
+void AppSettings::setDictionaryMemoryBudget(int megabytes)
+{
+    Q_D(AppSettings);
+    
+    d->dictionaryMemoryBudget = megabytes;
+    DictionaryManager::instance().setEvictionPolicy(d->dictionaryIdleTimeout, d->dictionaryMemoryBudget);
+}
+
 EditorWidth AppSettings::editorWidth() const
 {
     Q_D(const AppSettings);
@@ -761,6 +815,20 @@ AppSettings::AppSettings()
 
     d->locale = appSettings.value(GW_LOCALE_KEY, QLocale().name()).toString();
     d->liveSpellCheckEnabled = appSettings.value(GW_LIVE_SPELL_CHECK_KEY, QVariant(true)).toBool();
+    d->languageDetectionEnabled = appSettings.value(GW_DETECT_LANGUAGE_KEY, QVariant(false)).toBool();
+    d->dictionaryIdleTimeout = appSettings.value(GW_DICTIONARY_IDLE_TIMEOUT_KEY, QVariant(10)).toInt();
+    d->dictionaryMemoryBudget = appSettings.value(GW_DICTIONARY_MEMORY_BUDGET_KEY, QVariant(200)).toInt();
+
+    if (d->dictionaryIdleTimeout < 1) {
+        d->dictionaryIdleTimeout = 10;
+    }
+
+    if (d->dictionaryMemoryBudget < 0) {
+        d->dictionaryMemoryBudget = 200;
+    }
+
+    DictionaryManager::instance().setEvictionPolicy(d->dictionaryIdleTimeout, d->dictionaryMemoryBudget);
+    DictionaryManager::instance().setDetectLanguage(d->languageDetectionEnabled);
     d->editorWidth = (EditorWidth) appSettings.value(GW_EDITOR_WIDTH_KEY, QVariant(EditorWidthMedium)).toInt();
     d->interfaceStyle = (InterfaceStyle) appSettings.value(GW_INTERFACE_STYLE_KEY, QVariant(InterfaceStyleRounded)).toInt();
     d->italicizeBlockquotes = appSettings.value(GW_BLOCKQUOTE_STYLE_KEY, QVariant(false)).toBool();
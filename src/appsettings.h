@@ -128,6 +128,15 @@ public:
     Q_SLOT void setLiveSpellCheckEnabled(bool enabled);
     Q_SIGNAL void liveSpellCheckChanged(bool enabled);
 
+    bool languageDetectionEnabled() const;
+    Q_SLOT void setLanguageDetectionEnabled(bool enabled);
+
+    int dictionaryIdleTimeout() const;
+    Q_SLOT void setDictionaryIdleTimeout(int minutes);
+
+    int dictionaryMemoryBudget() const;
+    Q_SLOT void setDictionaryMemoryBudget(int megabytes);
+
     EditorWidth editorWidth() const;
     void setEditorWidth(EditorWidth editorWidth);
     Q_SIGNAL void editorWidthChanged(EditorWidth editorWidth);
@@ -17,6 +17,8 @@
  *
  ***********************************************************************/
 
+#include <QByteArray>
+#include <QHash>
 #include <QMutex>
 
 #include "3rdparty/cmark-gfm/core/cmark-gfm-extension_api.h"
@@ -50,6 +52,19 @@ public:
     cmark_syntax_extension *tasklistExt;
 
     QMutex apiMutex;
+
+    // HTML of the top-level blocks rendered by renderToHtmlBlocks(), keyed
+    // by node type and source text.  Only valid for the options and link
+    // reference definitions it was rendered with.
+    QHash<QByteArray, QString> htmlCache;
+    int htmlCacheOptions;
+    QByteArray htmlCacheDefinitions;
+
+    static QByteArray definitionLines
+    (
+        const QByteArray &text,
+        const QVector<int> &lineStarts
+    );
 };
 
 CmarkGfmAPI *CmarkGfmAPIPrivate::instance = nullptr;
@@ -137,11 +152,140 @@ QString CmarkGfmAPI::renderToHtml(const QString &text, const bool smartTypograph
     return html;
 }
 
+QVector<HtmlBlock> CmarkGfmAPI::renderToHtmlBlocks
+(
+    const QString &text,
+    const bool smartTypographyEnabled
+)
+{
+    Q_D(CmarkGfmAPI);
+
+    QVector<HtmlBlock> blocks;
+    int opts = CMARK_OPT_DEFAULT | CMARK_OPT_FOOTNOTES | CMARK_OPT_UNSAFE;
+
+    if (smartTypographyEnabled) {
+        opts |= CMARK_OPT_SMART;
+    }
+
+    QByteArray utf8 = text.toUtf8();
+
+    d->apiMutex.lock();
+
+    cmark_mem *mem = cmark_get_arena_mem_allocator();
+    cmark_parser *parser = cmark_parser_new_with_mem(opts, mem);
+
+    cmark_parser_attach_syntax_extension(parser, d->tableExt);
+    cmark_parser_attach_syntax_extension(parser, d->strikethroughExt);
+    cmark_parser_attach_syntax_extension(parser, d->autolinkExt);
+    cmark_parser_attach_syntax_extension(parser, d->tagfilterExt);
+    cmark_parser_attach_syntax_extension(parser, d->tasklistExt);
+
+    cmark_parser_feed(parser, utf8.data(), utf8.length());
+
+    cmark_node *root = cmark_parser_finish(parser);
+    cmark_llist *extensions = cmark_parser_get_syntax_extensions(parser);
+
+    // Offsets of the start of each line, plus one past the end of the
+    // text, for looking up the source text of the blocks.
+    QVector<int> lineStarts;
+    lineStarts.append(0);
+
+    for (int i = 0; i < utf8.length(); i++) {
+        if ('\n' == utf8[i]) {
+            lineStarts.append(i + 1);
+        }
+    }
+
+    lineStarts.append(utf8.length() + 1);
+
+    // Links are resolved against the reference definitions of the whole
+    // document, so a block's HTML can change along with any of them even
+    // if its own text didn't.
+    //
+    QByteArray definitions = CmarkGfmAPIPrivate::definitionLines(utf8, lineStarts);
+
+    if ((opts != d->htmlCacheOptions) || (definitions != d->htmlCacheDefinitions)) {
+        d->htmlCache.clear();
+        d->htmlCacheOptions = opts;
+        d->htmlCacheDefinitions = definitions;
+    }
+
+    // Blocks not rendered this time are dropped from the cache.
+    QHash<QByteArray, QString> htmlCache;
+
+    // The renderer numbers footnotes and wraps them in a section as it
+    // goes, so all footnote definitions must be rendered in one pass.
+    // Move them into a document of their own.
+    //
+    cmark_node *footnotes = cmark_node_new_with_mem(CMARK_NODE_DOCUMENT, mem);
+    cmark_node *node = cmark_node_first_child(root);
+
+    while (nullptr != node) {
+        cmark_node *next = cmark_node_next(node);
+
+        if (CMARK_NODE_FOOTNOTE_DEFINITION == cmark_node_get_type(node)) {
+            cmark_node_unlink(node);
+            cmark_node_append_child(footnotes, node);
+        } else {
+            int startLine = qMax(cmark_node_get_start_line(node), 1);
+            int endLine = qMin(cmark_node_get_end_line(node), lineStarts.size() - 1);
+            int start = lineStarts[startLine - 1];
+
+            QByteArray key(1, (char) cmark_node_get_type(node));
+            key += utf8.mid(start, lineStarts[endLine] - 1 - start);
+
+            QString html;
+
+            // Footnote references are numbered in order of appearance
+            // throughout the document, so blocks with any can't be reused.
+            //
+            bool cacheable = !key.contains("[^");
+
+            if (cacheable && d->htmlCache.contains(key)) {
+                html = d->htmlCache.value(key);
+            } else {
+                html = QString::fromUtf8(cmark_render_html(node, opts, extensions));
+            }
+
+            if (cacheable) {
+                htmlCache.insert(key, html);
+            }
+
+            blocks.append(HtmlBlock(html, startLine, endLine));
+        }
+
+        node = next;
+    }
+
+    // The footnotes are displayed after everything else, so they are
+    // given the line following the end of the document, rather than the
+    // lines of their definitions, to keep the lines of the blocks in
+    // order.
+    //
+    if (nullptr != cmark_node_first_child(footnotes)) {
+        char *output = cmark_render_html(footnotes, opts, extensions);
+        int line = lineStarts.size();
+
+        blocks.append(HtmlBlock(QString::fromUtf8(output), line, line));
+    }
+
+    d->htmlCache = htmlCache;
+
+    cmark_parser_free(parser);
+    cmark_arena_reset();
+
+    d->apiMutex.unlock();
+
+    return blocks;
+}
+
 CmarkGfmAPI::CmarkGfmAPI()
     : d_ptr(new CmarkGfmAPIPrivate())
 {
     Q_D(CmarkGfmAPI);
     
+    d->htmlCacheOptions = 0;
+
     cmark_gfm_core_extensions_ensure_registered();
     d->tableExt = cmark_find_syntax_extension("table");
     d->strikethroughExt = cmark_find_syntax_extension("strikethrough");
@@ -149,4 +293,37 @@ CmarkGfmAPI::CmarkGfmAPI()
     d->tagfilterExt = cmark_find_syntax_extension("tagfilter");
     d->tasklistExt = cmark_find_syntax_extension("tasklist");
 }
+
+QByteArray CmarkGfmAPIPrivate::definitionLines
+(
+    const QByteArray &text,
+    const QVector<int> &lineStarts
+)
+{
+    QByteArray definitions;
+    int lineCount = lineStarts.size() - 1;
+    int next = 0;
+
+    // Every link reference or footnote definition has "]:" on the line
+    // where its label ends.  Take that line along with the one before it
+    // for labels that wrap, and the two after it for the URL and title.
+    //
+    for (int i = 0; i < lineCount; i++) {
+        int start = lineStarts[i];
+        int length = lineStarts[i + 1] - start;
+
+        if (text.mid(start, length).contains("]:")) {
+            int first = qMax(i - 1, next);
+            int last = qMin(i + 2, lineCount - 1);
+
+            for (int line = first; line <= last; line++) {
+                definitions += text.mid(lineStarts[line], lineStarts[line + 1] - lineStarts[line]);
+            }
+
+            next = qMax(next, last + 1);
+        }
+    }
+
+    return definitions;
+}
 }
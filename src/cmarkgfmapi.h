@@ -21,7 +21,9 @@
 #define CMARK_PROCESSOR_H
 
 #include <QScopedPointer>
+#include <QVector>
 
+#include "htmlblock.h"
 #include "markdownast.h"
 
 namespace ghostwriter
@@ -58,6 +60,18 @@ public:
      */
     QString renderToHtml(const QString &text, const bool smartTypographyEnabled);
 
+    /**
+     * Returns the HTML for the Markdown text, rendered separately for
+     * each top-level block.  Footnote definitions are rendered together
+     * as the last block.  Pass in true for smartTypographyEnabled to
+     * enable smart typography.
+     */
+    QVector<HtmlBlock> renderToHtmlBlocks
+    (
+        const QString &text,
+        const bool smartTypographyEnabled
+    );
+
 private:
     QScopedPointer<CmarkGfmAPIPrivate> d_ptr;
 
@@ -46,6 +46,15 @@ void CmarkGfmExporter::exportToHtml(const QString &text, QString &html)
     html = CmarkGfmAPI::instance()->renderToHtml(text, this->m_smartTypographyEnabled);
 }
 
+void CmarkGfmExporter::exportToHtmlBlocks
+(
+    const QString &text,
+    QVector<HtmlBlock> &blocks
+)
+{
+    blocks = CmarkGfmAPI::instance()->renderToHtmlBlocks(text, this->m_smartTypographyEnabled);
+}
+
 void CmarkGfmExporter::exportToFile
 (
     const ExportFormat *format,
@@ -46,6 +46,12 @@ public:
      */
     void exportToHtml(const QString &text, QString &html);
 
+    /**
+     * Exports the given Markdown text to HTML, rendering each top-level
+     * block separately.
+     */
+    void exportToHtmlBlocks(const QString &text, QVector<HtmlBlock> &blocks);
+
     /**
      * Exports the given Markdown text to the given export format and
      * output file path.  Sets err to a non-null string error message
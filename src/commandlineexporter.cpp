@@ -21,11 +21,47 @@
 #include <QFileInfo>
 #include <QObject>
 #include <QDir>
-
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QRegularExpression>
+#include <QSet>
+#include <QTextCodec>
+#include <QTextDecoder>
+#include <QThreadStorage>
+
+#include "cmarkgfmapi.h"
 #include "commandlineexporter.h"
 
 namespace ghostwriter
 {
+/*
+* Long-lived render server process, along with the expanded command it
+* was started with.
+*/
+struct RenderServer
+{
+    RenderServer()
+        : written(0), responseLength(-1)
+    {
+        ;
+    }
+
+    QProcess process;
+    QString command;
+
+    // Request in progress, framed with its length, and its response so
+    // far.  A request abandoned because its render was cancelled stays
+    // here, and is finished before the next one with its response
+    // discarded, since the server answers requests in order.
+    //
+    QByteArray frame;
+    int written;
+    int responseLength;
+    QByteArray response;
+};
+
 class CommandLineExporterPrivate
 {
 public:
@@ -43,6 +79,80 @@ public:
     QString smartTypographyOnArgument = "";
     QString smartTypographyOffArgument = "";
     QString htmlRenderCommand = QString();
+    QString htmlRenderServerCommand = QString();
+
+    // A QProcess can only be used from the thread that created it, so
+    // each thread rendering HTML gets a server of its own.  The server is
+    // stopped when its thread exits.
+    //
+    QThreadStorage<RenderServer *> renderServers;
+
+    enum ExchangeResult
+    {
+        ExchangeFinished,
+        ExchangeCancelled,
+        ExchangeFailed
+    };
+
+    // Time allowed for a command or render server request, and the
+    // interval at which progress and cancellation are checked while
+    // waiting on the process.
+    //
+    int timeout = 30000;
+    static const int POLL_INTERVAL_MS = 50;
+
+    bool keyValueMetadataEnabled = false;
+
+    // Size of the chunks of text written to the process at a time.
+    static const int WRITE_CHUNK_SIZE = 64 * 1024;
+
+    // Paragraph placed between sections rendered in one run, to find
+    // where the HTML of each section ends.
+    static const QString SECTION_BREAK;
+
+    // HTML of the sections rendered by exportToHtmlBlocks(), keyed by a
+    // hash of their text, preamble, and smart typography setting.
+    QHash<QByteArray, QString> sectionCache;
+    QMutex sectionCacheMutex;
+
+    void splitSections
+    (
+        const QString &text,
+        const QStringList &lines,
+        QString &preamble,
+        QVector<int> &sectionStarts
+    ) const;
+
+    static void makeHeadingIdsUnique(QVector<HtmlBlock> &blocks);
+
+    bool renderHtml
+    (
+        const QString &text,
+        const bool smartTypographyEnabled,
+        QString &html
+    );
+
+    QString expandSmartTypographyArgument
+    (
+        const QString &command,
+        const bool smartTypographyEnabled
+    ) const;
+
+    bool renderWithServer
+    (
+        const QString &textInput,
+        const bool smartTypographyEnabled,
+        QString &html
+    );
+
+    ExchangeResult exchange(RenderServer &server);
+
+    static int writeChunk
+    (
+        QProcess &process,
+        const QByteArray &data,
+        int offset
+    );
 
     bool executeCommand
     (
@@ -56,6 +166,8 @@ public:
     );
 };
 
+const QString CommandLineExporterPrivate::SECTION_BREAK = QString("GhostwriterSectionBreak3f9c2a71");
+
 const QString CommandLineExporter::OUTPUT_FILE_PATH_VAR = QString("${OUTPUT_FILE_PATH}");
 const QString CommandLineExporter::SMART_TYPOGRAPHY_ARG = QString("${SMART_TYPOGRAPHY_ARG}");
 
@@ -79,6 +191,27 @@ void CommandLineExporter::setHtmlRenderCommand(const QString &command)
     d->htmlRenderCommand = command;
 }
 
+void CommandLineExporter::setHtmlRenderServerCommand(const QString &command)
+{
+    Q_D(CommandLineExporter);
+
+    d->htmlRenderServerCommand = command;
+}
+
+void CommandLineExporter::setTimeout(int msecs)
+{
+    Q_D(CommandLineExporter);
+
+    d->timeout = msecs;
+}
+
+void CommandLineExporter::setKeyValueMetadataEnabled(bool enabled)
+{
+    Q_D(CommandLineExporter);
+
+    d->keyValueMetadataEnabled = enabled;
+}
+
 void CommandLineExporter::addFileExportCommand
 (
     const ExportFormat *format,
@@ -122,35 +255,139 @@ void CommandLineExporter::setSmartTypographyOffArgument(const QString &argument)
 void CommandLineExporter::exportToHtml(const QString &text, QString &html)
 {
     Q_D(CommandLineExporter);
-    
-    QString stderrOutput;
 
-    if (d->htmlRenderCommand.isNull() || d->htmlRenderCommand.isEmpty()) {
-        html = "<center><b style='color: red'>HTML is not supported for this processor.</b></center>";
-        return;
-    }
+    d->renderHtml(text, this->m_smartTypographyEnabled, html);
+}
 
+void CommandLineExporter::exportToHtmlBlocks
+(
+    const QString &text,
+    QVector<HtmlBlock> &blocks
+)
+{
+    Q_D(CommandLineExporter);
+
+    // Footnotes are numbered across the whole document, so documents
+    // having any can't be rendered a section at a time.
+    //
     if
     (
-        ! d->executeCommand
-        (
-            d->htmlRenderCommand,
-            QString(),
-            text,
-            QString(),
-            this->m_smartTypographyEnabled,
-            html,
-            stderrOutput
-        )
+        (d->htmlRenderCommand.isEmpty() && d->htmlRenderServerCommand.isEmpty())
+        || text.contains("[^")
     ) {
-        QString errorMessage = d->htmlRenderCommand;
+        Exporter::exportToHtmlBlocks(text, blocks);
+        return;
+    }
 
-        if (!stderrOutput.isNull() && !stderrOutput.isEmpty()) {
-            errorMessage = stderrOutput;
+    QStringList lines = text.split('\n');
+    QString preamble;
+    QVector<int> sectionStarts;
+
+    d->splitSections(text, lines, preamble, sectionStarts);
+
+    if (sectionStarts.size() < 2) {
+        Exporter::exportToHtmlBlocks(text, blocks);
+        return;
+    }
+
+    sectionStarts.append(lines.size());
+
+    QVector<QByteArray> keys;
+    QStringList sections;
+    QVector<int> changed;
+
+    blocks.clear();
+
+    d->sectionCacheMutex.lock();
+
+    for (int i = 0; i < (sectionStarts.size() - 1); i++) {
+        int start = sectionStarts[i];
+        int end = sectionStarts[i + 1];
+        QString section = lines.mid(start, end - start).join('\n');
+
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(this->m_smartTypographyEnabled ? "1" : "0", 1);
+        hash.addData(preamble.toUtf8());
+        hash.addData("\0", 1);
+        hash.addData(section.toUtf8());
+
+        QByteArray key = hash.result();
+
+        keys.append(key);
+        sections.append(section);
+        blocks.append(HtmlBlock(d->sectionCache.value(key), start + 1, end));
+
+        if (!d->sectionCache.contains(key)) {
+            changed.append(i);
         }
+    }
 
-        html = QString("<center><b style='color: red'>") + QObject::tr("Export failed: ") + QString("%1</b></center>").arg(errorMessage);
+    d->sectionCacheMutex.unlock();
+
+    if (!changed.isEmpty()) {
+        // Render all the changed sections in one run, each followed by a
+        // section break.  The HTML before the first break belongs to the
+        // preamble, and is dropped.
+        //
+        QString batch = preamble + "\n\n" + CommandLineExporterPrivate::SECTION_BREAK + "\n\n";
+
+        foreach (int i, changed) {
+            batch += sections[i] + "\n\n" + CommandLineExporterPrivate::SECTION_BREAK + "\n\n";
+        }
+
+        QString html;
+        bool rendered = d->renderHtml(batch, this->m_smartTypographyEnabled, html);
+
+        // A newer render is wanted, so there is no point in finishing this
+        // one.  The cached sections are kept for it.
+        //
+        if (Exporter::isCancelled()) {
+            return;
+        }
+
+        // A processor error is shown as it is, rather than rendering the
+        // whole document only for it to fail again.
+        //
+        if (!rendered) {
+            blocks.clear();
+            blocks.append(HtmlBlock(html, 1, lines.size()));
+            return;
+        }
+
+        QStringList fragments =
+            html.split
+            (
+                QRegularExpression
+                (
+                    QString("<p>\\s*%1\\s*</p>").arg(CommandLineExporterPrivate::SECTION_BREAK)
+                )
+            );
+
+        // A section that swallowed the break that follows it (such as an
+        // unterminated HTML block) leaves the fragments unaccounted for.
+        //
+        if (fragments.size() != (changed.size() + 2)) {
+            Exporter::exportToHtmlBlocks(text, blocks);
+            return;
+        }
+
+        for (int j = 0; j < changed.size(); j++) {
+            blocks[changed[j]].html = fragments[j + 1];
+        }
     }
+
+    // Keep only the sections of the current text in the cache.
+    QHash<QByteArray, QString> sectionCache;
+
+    for (int i = 0; i < blocks.size(); i++) {
+        sectionCache.insert(keys[i], blocks[i].html);
+    }
+
+    d->sectionCacheMutex.lock();
+    d->sectionCache = sectionCache;
+    d->sectionCacheMutex.unlock();
+
+    CommandLineExporterPrivate::makeHeadingIdsUnique(blocks);
 }
 
 void CommandLineExporter::exportToFile
@@ -197,37 +434,13 @@ void CommandLineExporter::exportToFile
     }
 }
 
-bool CommandLineExporterPrivate::executeCommand
+QString CommandLineExporterPrivate::expandSmartTypographyArgument
 (
     const QString &command,
-    const QString &inputFilePath,
-    const QString &textInput,
-    const QString &outputFilePath,
-    const bool smartTypographyEnabled,
-    QString &stdoutOutput,
-    QString &stderrOutput
-)
+    const bool smartTypographyEnabled
+) const
 {
-    QProcess process;
-    process.setReadChannel(QProcess::StandardOutput);
-
-    QString expandedCommand = command + QString(" ");
-
-    if (!outputFilePath.isNull() && !outputFilePath.isEmpty()) {
-        // Redirect stdout to the output file path if the path variable wasn't
-        // set in the command string.
-        //
-        if (!expandedCommand.contains(CommandLineExporter::OUTPUT_FILE_PATH_VAR)) {
-            process.setStandardOutputFile(outputFilePath);
-        } else {
-            // Surround file path with quotes in case there are spaces in the
-            // path.
-            //
-            QString outputFilePathWithQuotes = QString('\"') +
-                                               outputFilePath + '\"';
-            expandedCommand.replace(CommandLineExporter::OUTPUT_FILE_PATH_VAR, outputFilePathWithQuotes);
-        }
-    }
+    QString expandedCommand = command;
 
     if
     (
@@ -260,34 +473,467 @@ bool CommandLineExporterPrivate::executeCommand
         );
     }
 
-    if (!inputFilePath.isNull() && !inputFilePath.isEmpty()) {
-        process.setWorkingDirectory(QFileInfo(inputFilePath).dir().path());
+    return expandedCommand;
+}
+
+bool CommandLineExporterPrivate::renderHtml
+(
+    const QString &text,
+    const bool smartTypographyEnabled,
+    QString &html
+)
+{
+    QString stderrOutput;
+
+    if (!htmlRenderServerCommand.isEmpty()) {
+        if (renderWithServer(text, smartTypographyEnabled, html)) {
+            return true;
+        }
+
+        // A cancelled request isn't a server failure, so don't fall back
+        // to starting a process for a render that is no longer wanted.
+        if (Exporter::isCancelled()) {
+            return false;
+        }
     }
 
-    process.start(expandedCommand);
+    if (htmlRenderCommand.isNull() || htmlRenderCommand.isEmpty()) {
+        html = "<center><b style='color: red'>HTML is not supported for this processor.</b></center>";
+        return false;
+    }
+
+    if
+    (
+        !executeCommand
+        (
+            htmlRenderCommand,
+            QString(),
+            text,
+            QString(),
+            smartTypographyEnabled,
+            html,
+            stderrOutput
+        )
+    ) {
+        QString errorMessage = htmlRenderCommand;
 
-    if (!process.waitForStarted()) {
+        if (!stderrOutput.isNull() && !stderrOutput.isEmpty()) {
+            errorMessage = stderrOutput;
+        }
+
+        html = QString("<center><b style='color: red'>") + QObject::tr("Export failed: ") + QString("%1</b></center>").arg(errorMessage);
         return false;
-    } else {
-        if (!textInput.isNull() && !textInput.isEmpty()) {
-            process.write(textInput.toUtf8());
-            process.closeWriteChannel();
+    }
+
+    return true;
+}
+
+bool CommandLineExporterPrivate::renderWithServer
+(
+    const QString &textInput,
+    const bool smartTypographyEnabled,
+    QString &html
+)
+{
+    QString command =
+        expandSmartTypographyArgument
+        (
+            htmlRenderServerCommand,
+            smartTypographyEnabled
+        );
+
+    QByteArray request = textInput.toUtf8();
+
+    // If the server crashed since the last request, or crashes on this
+    // one, restart it once.
+    //
+    for (int attempt = 0; attempt < 2; attempt++) {
+        RenderServer *server = renderServers.localData();
+
+        if
+        (
+            (nullptr == server)
+            || (server->command != command)
+            || (QProcess::Running != server->process.state())
+        ) {
+            server = new RenderServer();
+            server->command = command;
+            server->process.setStandardErrorFile(QProcess::nullDevice());
+
+            // Replaces (and deletes) the previous server, if any.
+            renderServers.setLocalData(server);
+
+            server->process.start(command);
+
+            if (!server->process.waitForStarted()) {
+                renderServers.setLocalData(nullptr);
+                return false;
+            }
+        }
+
+        ExchangeResult result = ExchangeFinished;
+
+        // Finish the request of a cancelled render first.
+        if (!server->frame.isEmpty()) {
+            result = exchange(*server);
         }
 
-        if (!process.waitForFinished()) {
+        if ((ExchangeFinished == result) && Exporter::isCancelled()) {
             return false;
-        } else {
-            stdoutOutput = QString::fromUtf8(process.readAllStandardOutput().data());
-            stderrOutput = QString::fromUtf8(process.readAllStandardError().data());
+        }
+
+        if (ExchangeFinished == result) {
+            server->frame = QByteArray::number(request.length()) + '\n' + request;
+            server->written = 0;
+            server->responseLength = -1;
+            server->response.clear();
+
+            result = exchange(*server);
+        }
+
+        if (ExchangeFinished == result) {
+            html = QString::fromUtf8(server->response);
+            server->response.clear();
+            return true;
+        }
+
+        // Keep the server running if the render was merely cancelled, since
+        // that happens on every keystroke while a render is in progress.
+        //
+        if (ExchangeCancelled == result) {
+            return false;
+        }
+
+        // The server is out of step with the protocol after a failed
+        // request, so it has to be restarted.
+        renderServers.setLocalData(nullptr);
+    }
+
+    return false;
+}
+
+CommandLineExporterPrivate::ExchangeResult CommandLineExporterPrivate::exchange
+(
+    RenderServer &server
+)
+{
+    QProcess &process = server.process;
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    // Keep reading while writing, in case the server starts replying
+    // before it has read the whole request.
+    //
+    while
+    (
+        (server.written < server.frame.length())
+        || (server.responseLength < 0)
+        || (server.response.length() < server.responseLength)
+    ) {
+        server.written += writeChunk(process, server.frame, server.written);
+
+        if ((server.responseLength < 0) && process.canReadLine()) {
+            bool ok = false;
+            server.responseLength = process.readLine().trimmed().toInt(&ok);
+
+            if (!ok || (server.responseLength < 0)) {
+                return ExchangeFailed;
+            }
+
+            server.response.reserve(server.responseLength);
+        }
+
+        if (server.responseLength >= 0) {
+            server.response += process.read(server.responseLength - server.response.length());
 
             if
             (
-                (QProcess::NormalExit != process.exitStatus()) ||
-                (0 != process.exitCode())
+                (server.written >= server.frame.length())
+                && (server.response.length() >= server.responseLength)
             ) {
-                return false;
+                break;
+            }
+        }
+
+        if ((QProcess::Running != process.state()) || elapsed.hasExpired(timeout)) {
+            return ExchangeFailed;
+        }
+
+        if (Exporter::isCancelled()) {
+            return ExchangeCancelled;
+        }
+
+        if (server.written < server.frame.length()) {
+            process.waitForBytesWritten(POLL_INTERVAL_MS);
+        } else {
+            process.waitForReadyRead(POLL_INTERVAL_MS);
+        }
+    }
+
+    server.frame.clear();
+
+    return ExchangeFinished;
+}
+
+int CommandLineExporterPrivate::writeChunk
+(
+    QProcess &process,
+    const QByteArray &data,
+    int offset
+)
+{
+    // Only hand over the next chunk once the previous one was taken up
+    // by the process, rather than buffering the whole document at once.
+    //
+    if ((offset >= data.length()) || (process.bytesToWrite() > 0)) {
+        return 0;
+    }
+
+    int length = qMin(WRITE_CHUNK_SIZE, data.length() - offset);
+
+    return qMax(process.write(data.constData() + offset, length), (qint64) 0);
+}
+
+void CommandLineExporterPrivate::splitSections
+(
+    const QString &text,
+    const QStringList &lines,
+    QString &preamble,
+    QVector<int> &sectionStarts
+) const
+{
+    int contentStart = 0;
+
+    // A metadata block at the start of the document goes into the
+    // preamble rather than into the first section.
+    //
+    if ((lines.size() > 1) && ("---" == lines[0].trimmed())) {
+        for (int i = 1; i < lines.size(); i++) {
+            QString line = lines[i].trimmed();
+
+            if (("---" == line) || ("..." == line)) {
+                contentStart = i + 1;
+                break;
+            }
+        }
+    } else if (keyValueMetadataEnabled) {
+        // MultiMarkdown metadata runs up to the first blank line, with
+        // each value possibly continued on indented lines.
+        //
+        static const QRegularExpression keyExp("^[A-Za-z0-9][A-Za-z0-9 _-]*:(\\s|$)");
+
+        if (!lines.isEmpty() && keyExp.match(lines[0]).hasMatch()) {
+            contentStart = lines.size();
+
+            for (int i = 1; i < lines.size(); i++) {
+                if (lines[i].trimmed().isEmpty()) {
+                    contentStart = i + 1;
+                    break;
+                }
+
+                if (!lines[i][0].isSpace() && !keyExp.match(lines[i]).hasMatch()) {
+                    // Not metadata after all.
+                    contentStart = 0;
+                    break;
+                }
+            }
+        }
+    }
+
+    preamble = lines.mid(0, contentStart).join('\n');
+
+    // Every section needs the link reference definitions of the whole
+    // document to resolve its links.
+    //
+    static const QRegularExpression definitionExp("^ {0,3}\\[[^\\]]+\\]:");
+
+    for (int i = contentStart; i < lines.size(); i++) {
+        if (definitionExp.match(lines[i]).hasMatch()) {
+            preamble += "\n\n" + lines[i];
+        }
+    }
+
+    sectionStarts.clear();
+
+    if (contentStart < lines.size()) {
+        sectionStarts.append(contentStart);
+    }
+
+    MarkdownAST *ast = CmarkGfmAPI::instance()->parse(text, false);
+
+    // Only split at headings that follow a blank line, since some
+    // processors don't recognize headings that interrupt a paragraph.
+    //
+    foreach (MarkdownNode *heading, ast->headings()) {
+        int line = heading->startLine() - 1;
+
+        if
+        (
+            (line > contentStart)
+            && (line < lines.size())
+            && lines[line - 1].trimmed().isEmpty()
+        ) {
+            sectionStarts.append(line);
+        }
+    }
+
+    delete ast;
+}
+
+void CommandLineExporterPrivate::makeHeadingIdsUnique(QVector<HtmlBlock> &blocks)
+{
+    // Processors number the ids they generate for headings having the
+    // same title, but only within a single run, so number the ones that
+    // sections rendered in different runs have in common.
+    //
+    static const QRegularExpression idExp("(<h[1-6][^>]*\\sid=\")([^\"]*)\"");
+
+    QSet<QString> ids;
+
+    for (int i = 0; i < blocks.size(); i++) {
+        QString &html = blocks[i].html;
+        QRegularExpressionMatchIterator matches = idExp.globalMatch(html);
+        QVector<QRegularExpressionMatch> duplicates;
+        QStringList uniqueIds;
+
+        while (matches.hasNext()) {
+            QRegularExpressionMatch match = matches.next();
+            QString id = match.captured(2);
+
+            if (ids.contains(id)) {
+                QString uniqueId;
+                int n = 1;
+
+                do {
+                    uniqueId = QString("%1-%2").arg(id).arg(n++);
+                } while (ids.contains(uniqueId));
+
+                duplicates.append(match);
+                uniqueIds.append(uniqueId);
+                id = uniqueId;
             }
+
+            ids.insert(id);
         }
+
+        // Replace from the end, so that the positions of the other
+        // matches stay valid.
+        //
+        for (int j = duplicates.size() - 1; j >= 0; j--) {
+            html.replace(duplicates[j].capturedStart(2), duplicates[j].capturedLength(2), uniqueIds[j]);
+        }
+    }
+}
+
+bool CommandLineExporterPrivate::executeCommand
+(
+    const QString &command,
+    const QString &inputFilePath,
+    const QString &textInput,
+    const QString &outputFilePath,
+    const bool smartTypographyEnabled,
+    QString &stdoutOutput,
+    QString &stderrOutput
+)
+{
+    QProcess process;
+    process.setReadChannel(QProcess::StandardOutput);
+
+    QString expandedCommand = command + QString(" ");
+
+    if (!outputFilePath.isNull() && !outputFilePath.isEmpty()) {
+        // Redirect stdout to the output file path if the path variable wasn't
+        // set in the command string.
+        //
+        if (!expandedCommand.contains(CommandLineExporter::OUTPUT_FILE_PATH_VAR)) {
+            process.setStandardOutputFile(outputFilePath);
+        } else {
+            // Surround file path with quotes in case there are spaces in the
+            // path.
+            //
+            QString outputFilePathWithQuotes = QString('\"') +
+                                               outputFilePath + '\"';
+            expandedCommand.replace(CommandLineExporter::OUTPUT_FILE_PATH_VAR, outputFilePathWithQuotes);
+        }
+    }
+
+    expandedCommand =
+        expandSmartTypographyArgument
+        (
+            expandedCommand,
+            smartTypographyEnabled
+        );
+
+    if (!inputFilePath.isNull() && !inputFilePath.isEmpty()) {
+        process.setWorkingDirectory(QFileInfo(inputFilePath).dir().path());
+    }
+
+    // Don't start a process whose output is no longer wanted.
+    if (Exporter::isCancelled()) {
+        return false;
+    }
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    process.start(expandedCommand);
+
+    if (!process.waitForStarted(timeout)) {
+        return false;
+    }
+
+    QByteArray input = textInput.toUtf8();
+    int written = 0;
+    QTextDecoder decoder(QTextCodec::codecForName("UTF-8"));
+
+    stdoutOutput = QString("");
+
+    if (input.isEmpty()) {
+        process.closeWriteChannel();
+    }
+
+    // Feed the text to the process in chunks while decoding its output
+    // as it arrives, checking in between whether to give up.
+    //
+    while (QProcess::NotRunning != process.state()) {
+        if (written < input.length()) {
+            written += writeChunk(process, input, written);
+
+            if (written >= input.length()) {
+                process.closeWriteChannel();
+            }
+        }
+
+        stdoutOutput += decoder.toUnicode(process.readAllStandardOutput());
+
+        if (Exporter::isCancelled() || elapsed.hasExpired(timeout)) {
+            if (Exporter::isCancelled()) {
+                stderrOutput = QObject::tr("Export was cancelled.");
+            } else {
+                stderrOutput = QObject::tr("Export timed out.");
+            }
+
+            process.kill();
+            process.waitForFinished(POLL_INTERVAL_MS);
+            return false;
+        }
+
+        if (written < input.length()) {
+            process.waitForBytesWritten(POLL_INTERVAL_MS);
+        } else {
+            process.waitForFinished(POLL_INTERVAL_MS);
+        }
+    }
+
+    stdoutOutput += decoder.toUnicode(process.readAllStandardOutput());
+    stderrOutput = QString::fromUtf8(process.readAllStandardError().data());
+
+    if
+    (
+        (QProcess::NormalExit != process.exitStatus()) ||
+        (0 != process.exitCode())
+    ) {
+        return false;
     }
 
     return true;
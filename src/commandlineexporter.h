@@ -57,6 +57,35 @@ public:
      */
     void setHtmlRenderCommand(const QString &command);
 
+    /**
+     * Sets the command to start a long-lived render server for the Live
+     * HTML Preview, which spares starting a new process for every update.
+     * An empty command (the default) disables the server.
+     *
+     * The server reads documents from stdin and writes their HTML to
+     * stdout, each framed as its length in bytes as a decimal number on
+     * a line of its own, followed by that many bytes of UTF-8 text.  The
+     * SMART_TYPOGRAPHY_ARG variable is expanded the same way as for
+     * setHtmlRenderCommand(), and the server is restarted whenever smart
+     * typography is toggled or the process exits.  If the server can't be
+     * started or stops responding, the render command is used instead.
+     */
+    void setHtmlRenderServerCommand(const QString &command);
+
+    /**
+     * Sets the time in milliseconds that a command or render server
+     * request may take before it is abandoned.  The default is 30 seconds.
+     */
+    void setTimeout(int msecs);
+
+    /**
+     * Sets whether the processor reads MultiMarkdown metadata, that is,
+     * "Key: value" lines at the start of the document, so that they are
+     * kept with the document's preamble when it is rendered a section
+     * at a time.  The default is false.
+     */
+    void setKeyValueMetadataEnabled(bool enabled);
+
     /**
      * Adds a command to execute for exporting text to the specified
      * export format.
@@ -97,6 +126,15 @@ public:
      */
     void exportToHtml(const QString &text, QString &html);
 
+    /**
+     * Exports the given text to html for use in the Live HTML Preview,
+     * split into sections at its top-level headings.  Only the sections
+     * that changed since the last call are sent to the processor, in a
+     * single run, preceded by the document's metadata block and link
+     * reference definitions.  The HTML of the other sections is reused.
+     */
+    void exportToHtmlBlocks(const QString &text, QVector<HtmlBlock> &blocks);
+
     /**
      * Exports the given text to the given format and output file path.
      * If the command to export fails, err will be set to a non-null
@@ -17,13 +17,61 @@
  *
  ***********************************************************************/
 
+#include <QFutureWatcher>
+#include <QSet>
+#include <QTimer>
+#include <QtConcurrentRun>
 #include <QtCore/qmath.h>
-#include <QTextBoundaryFinder>
 
 #include "documentstatistics.h"
+#include "fenwicktree.h"
+#include "sentencesegmenter.h"
+#include "wordsegmenter.h"
 
 namespace ghostwriter
 {
+/*
+ * Statistics of a single text block, or sums of them over a range of blocks.
+ */
+struct BlockStatistics
+{
+    BlockStatistics()
+        : words(0),
+          longWords(0),
+          wordCharacters(0),
+          sentences(0),
+          paragraphs(0)
+    {
+        ;
+    }
+
+    BlockStatistics &operator+=(const BlockStatistics &other)
+    {
+        words += other.words;
+        longWords += other.longWords;
+        wordCharacters += other.wordCharacters;
+        sentences += other.sentences;
+        paragraphs += other.paragraphs;
+        return *this;
+    }
+
+    BlockStatistics &operator-=(const BlockStatistics &other)
+    {
+        words -= other.words;
+        longWords -= other.longWords;
+        wordCharacters -= other.wordCharacters;
+        sentences -= other.sentences;
+        paragraphs -= other.paragraphs;
+        return *this;
+    }
+
+    int words;
+    int longWords;
+    int wordCharacters;
+    int sentences;
+    int paragraphs;
+};
+
 class DocumentStatisticsPrivate
 {
     Q_DECLARE_PUBLIC(DocumentStatistics)
@@ -31,7 +79,10 @@ class DocumentStatisticsPrivate
 public:
 
     DocumentStatisticsPrivate(DocumentStatistics *q_ptr)
-        : q_ptr(q_ptr)
+        : q_ptr(q_ptr),
+          textSelected(false),
+          wordCountScheduled(false),
+          runningWordCounts(0)
     {
         ;
     }
@@ -61,16 +112,52 @@ public:
     int paragraphCount;
     int lixLongWordCount;
 
+    WordSegmenter wordSegmenter;
+
+    // Prefix sums of the block statistics in block order, so that
+    // statistics for any range of blocks can be found without recounting
+    // their text.  Rebuilt on demand after blocks are added or removed,
+    // since that changes the block numbers.
+    FenwickTree<BlockStatistics> blockIndex;
+    bool blockIndexValid;
+
+    bool textSelected;
+
+    // Statistics are published at most once per update interval.  The
+    // pending snapshot is published when the timer expires, if it differs
+    // from the one published last.
+    QTimer publishTimer;
+    StatisticsSnapshot pendingSnapshot;
+    StatisticsSnapshot publishedSnapshot;
+
+    // Blocks whose prose changed and whose words need to be recounted in
+    // the background.
+    QVector<QTextBlock> wordCountBlocks;
+    bool wordCountScheduled;
+    int runningWordCounts;
+
     void updateStatistics();
+    void publish(const StatisticsSnapshot &snapshot);
+    StatisticsSnapshot snapshot(const BlockStatistics &statistics, int characters);
     void updateBlockStatistics(QTextBlock &block);
-    void countWords
+    void applyBlockDelta(const QTextBlock &block, const BlockStatistics &delta);
+    void startWordCount();
+    void onWordCountFinished
     (
-        const QString &text,
-        int &words,
-        int &lixLongWords,
-        int &alphaNumericCharacters
+        const QVector<QTextBlock> &blocks,
+        const QVector<uint> &keys,
+        const QVector<BlockStatistics> &counts
+    );
+    void checkWordCountSettled();
+    void updateBlockIndex();
+    BlockStatistics countText(const QString &text, const QString &prose);
+    static BlockStatistics blockStatistics(const QTextBlock &block);
+    static BlockStatistics blockStatistics(const TextBlockData *blockData);
+    static QVector<BlockStatistics> countWords
+    (
+        const WordSegmenter &segmenter,
+        const QStringList &texts
     );
-    int countSentences(const QString &text);
     int calculatePageCount(int words);
     int calculateCLI(int characters, int words, int sentences);
     int calculateLIX(int totalWords, int longWords, int sentences);
@@ -89,9 +176,16 @@ DocumentStatistics::DocumentStatistics(MarkdownDocument *document, QObject *pare
     d->sentenceCount = 0;
     d->paragraphCount = 0;
     d->lixLongWordCount = 0;
+    d->blockIndexValid = false;
+
+    // About one display frame.
+    d->publishTimer.setInterval(16);
+    d->publishTimer.setSingleShot(true);
 
+    connect(&d->publishTimer, SIGNAL(timeout()), this, SLOT(publishStatistics()));
     connect(d->document, SIGNAL(contentsChange(int, int, int)), this, SLOT(onTextChanged(int, int, int)));
-    connect(d->document, SIGNAL(textBlockRemoved(const QTextBlock &)), this, SLOT(onTextBlockRemoved(const QTextBlock &)));
+    connect(d->document, SIGNAL(textBlockRemoved(const TextBlockData *)), this, SLOT(onTextBlockRemoved(const TextBlockData *)));
+    connect(d->document, SIGNAL(textBlockProseChanged(const QTextBlock &)), this, SLOT(onTextBlockProseChanged(const QTextBlock &)));
 }
 
 DocumentStatistics::~DocumentStatistics()
@@ -106,6 +200,20 @@ int DocumentStatistics::wordCount() const
     return d->wordCount;
 }
 
+bool DocumentStatistics::isCountingWords() const
+{
+    Q_D(const DocumentStatistics);
+
+    return d->wordCountScheduled || (d->runningWordCounts > 0);
+}
+
+void DocumentStatistics::setUpdateInterval(int msecs)
+{
+    Q_D(DocumentStatistics);
+
+    d->publishTimer.setInterval(msecs);
+}
+
 void DocumentStatistics::onTextSelected
 (
     const QString &selectedText,
@@ -115,51 +223,62 @@ void DocumentStatistics::onTextSelected
 {
     Q_D(DocumentStatistics);
     
-    int selectionWordCount;
-    int selectionLixLongWordCount;
-    int selectionWordCharacterCount;
+    QTextBlock startBlock = d->document->findBlock(selectionStart);
+    QTextBlock endBlock = d->document->findBlock(selectionEnd);
 
-    d->countWords
-    (
-        selectedText,
-        selectionWordCount,
-        selectionLixLongWordCount,
-        selectionWordCharacterCount
-    );
-
-    int selectionSentenceCount = d->countSentences(selectedText);
+    if (!endBlock.isValid()) {
+        endBlock = d->document->lastBlock();
+    }
 
-    // Count the number of selected paragraphs.
-    int selectedParagraphCount = 0;
+    BlockStatistics selection;
 
-    QTextBlock block = d->document->findBlock(selectionStart);
-    QTextBlock end = d->document->findBlock(selectionEnd).next();
+    // Only the text of the partially selected blocks at either end of the
+    // selection is counted.  The statistics of the blocks in between are
+    // summed from the block index.
+    //
+    QString startProse = TextBlockData::proseText(startBlock);
+    int startOffset = selectionStart - startBlock.position();
 
-    while (block != end) {
-        TextBlockData *blockData = (TextBlockData *) block.userData();
+    d->textSelected = true;
 
-        if ((nullptr != blockData) && !blockData->blankLine) {
-            selectedParagraphCount++;
-        }
+    if (startBlock == endBlock) {
+        selection =
+            d->countText
+            (
+                selectedText,
+                startProse.mid(startOffset, selectionEnd - selectionStart)
+            );
+    } else {
+        int endOffset = selectionEnd - endBlock.position();
+
+        selection =
+            d->countText
+            (
+                startBlock.text().mid(startOffset),
+                startProse.mid(startOffset)
+            );
+        selection +=
+            d->countText
+            (
+                endBlock.text().left(endOffset),
+                TextBlockData::proseText(endBlock).left(endOffset)
+            );
 
-        block = block.next();
+        d->updateBlockIndex();
+        selection += d->blockIndex.rangeSum(startBlock.blockNumber() + 1, endBlock.blockNumber() - 1);
+        selection.paragraphs += DocumentStatisticsPrivate::blockStatistics(endBlock).paragraphs;
     }
 
-    emit wordCountChanged(selectionWordCount);
-    emit characterCountChanged(selectedText.length());
-    emit sentenceCountChanged(selectionSentenceCount);
-    emit paragraphCountChanged(selectedParagraphCount);
-    emit pageCountChanged(d->calculatePageCount(selectionWordCount));
-    emit complexWordsChanged(d->calculateComplexWords(selectionWordCount, selectionLixLongWordCount));
-    emit readingTimeChanged(d->calculateReadingTime(selectionWordCount));
-    emit lixReadingEaseChanged(d->calculateLIX(selectionWordCount, selectionLixLongWordCount, selectionSentenceCount));
-    emit readabilityIndexChanged(d->calculateCLI(selectionWordCharacterCount, selectionWordCount, selectionSentenceCount));
+    selection.paragraphs += DocumentStatisticsPrivate::blockStatistics(startBlock).paragraphs;
+
+    d->publish(d->snapshot(selection, selectedText.length()));
 }
 
 void DocumentStatistics::onTextDeselected()
 {
     Q_D(DocumentStatistics);
     
+    d->textSelected = false;
     d->updateStatistics();
 }
 
@@ -181,9 +300,10 @@ void DocumentStatistics::onTextChanged(int position, int charsRemoved, int chars
         endIndex = d->document->characterCount() - 1;
     }
 
-    // Update the word counts of affected blocks.  Note that there is no need to
-    // check for changes to section headings, since the Highlighter class will
-    // take care of this for us.
+    // Update the sentence and paragraph counts of affected blocks.  Word
+    // counts are updated when the prose of the blocks changes.  Note that
+    // there is no need to check for changes to section headings, since the
+    // Highlighter class will take care of this for us.
     //
     QTextBlock startBlock = d->document->findBlock(startIndex);
     QTextBlock endBlock = d->document->findBlock(endIndex);
@@ -200,40 +320,113 @@ void DocumentStatistics::onTextChanged(int position, int charsRemoved, int chars
     d->updateStatistics();
 }
 
-void DocumentStatistics::onTextBlockRemoved(const QTextBlock &block)
+void DocumentStatistics::onTextBlockRemoved(const TextBlockData *blockData)
 {
     Q_D(DocumentStatistics);
-    
-    TextBlockData *blockData = (TextBlockData *) block.userData();
 
-    if (nullptr != blockData) {
-        d->wordCount -= blockData->wordCount;
-        d->lixLongWordCount -= blockData->lixLongWordCount;
-        d->wordCharacterCount -= blockData->alphaNumericCharacterCount;
-        d->sentenceCount -= blockData->sentenceCount;
+    // Called once per removed block in the middle of the edit, so only
+    // take the block's cached statistics out of the totals here.  The
+    // statistics are published from onTextChanged() once the edit is done,
+    // and the index is rebuilt lazily since the block numbers shifted.
+    //
+    BlockStatistics removed = DocumentStatisticsPrivate::blockStatistics(blockData);
+
+    d->wordCount -= removed.words;
+    d->lixLongWordCount -= removed.longWords;
+    d->wordCharacterCount -= removed.wordCharacters;
+    d->sentenceCount -= removed.sentences;
+    d->paragraphCount -= removed.paragraphs;
+    d->blockIndexValid = false;
+}
 
-        if (!blockData->blankLine) {
-            d->paragraphCount--;
-        }
+void DocumentStatistics::onTextBlockProseChanged(const QTextBlock &block)
+{
+    Q_D(DocumentStatistics);
+
+    d->wordCountBlocks.append(block);
+
+    // Collect all the blocks changed by the current edit (or by parsing
+    // the document) into one background job.
+    if (!d->wordCountScheduled) {
+        d->wordCountScheduled = true;
+        QMetaObject::invokeMethod(this, "startWordCount", Qt::QueuedConnection);
+    }
+}
+
+void DocumentStatistics::startWordCount()
+{
+    Q_D(DocumentStatistics);
+
+    d->startWordCount();
+}
+
+void DocumentStatistics::publishStatistics()
+{
+    Q_D(DocumentStatistics);
 
-        d->updateStatistics();
+    if (d->pendingSnapshot == d->publishedSnapshot) {
+        return;
     }
+
+    d->publishedSnapshot = d->pendingSnapshot;
+    emit statisticsChanged(d->publishedSnapshot);
 }
 
 void DocumentStatisticsPrivate::updateStatistics()
 {
-    Q_Q(DocumentStatistics);
-    
-    emit q->wordCountChanged(wordCount);
-    emit q->totalWordCountChanged(wordCount);
-    emit q->characterCountChanged(document->characterCount() - 1);
-    emit q->sentenceCountChanged(sentenceCount);
-    emit q->paragraphCountChanged(paragraphCount);
-    emit q->pageCountChanged(calculatePageCount(wordCount));
-    emit q->complexWordsChanged(calculateComplexWords(wordCount, lixLongWordCount));
-    emit q->readingTimeChanged(calculateReadingTime(wordCount));
-    emit q->lixReadingEaseChanged(calculateLIX(wordCount, lixLongWordCount, sentenceCount));
-    emit q->readabilityIndexChanged(calculateCLI(wordCharacterCount, wordCount, sentenceCount));
+    BlockStatistics statistics;
+
+    statistics.words = wordCount;
+    statistics.longWords = lixLongWordCount;
+    statistics.wordCharacters = wordCharacterCount;
+    statistics.sentences = sentenceCount;
+    statistics.paragraphs = paragraphCount;
+
+    publish(snapshot(statistics, document->characterCount() - 1));
+}
+
+void DocumentStatisticsPrivate::publish(const StatisticsSnapshot &snapshot)
+{
+    pendingSnapshot = snapshot;
+
+    if (!publishTimer.isActive()) {
+        publishTimer.start();
+    }
+}
+
+StatisticsSnapshot DocumentStatisticsPrivate::snapshot
+(
+    const BlockStatistics &statistics,
+    int characters
+)
+{
+    StatisticsSnapshot snapshot;
+
+    snapshot.wordCount = statistics.words;
+    snapshot.totalWordCount = wordCount;
+    snapshot.characterCount = characters;
+    snapshot.sentenceCount = statistics.sentences;
+    snapshot.paragraphCount = statistics.paragraphs;
+    snapshot.pageCount = calculatePageCount(statistics.words);
+    snapshot.complexWords =
+        calculateComplexWords(statistics.words, statistics.longWords);
+    snapshot.readingTime = calculateReadingTime(statistics.words);
+    snapshot.lixReadingEase =
+        calculateLIX
+        (
+            statistics.words,
+            statistics.longWords,
+            statistics.sentences
+        );
+    snapshot.readabilityIndex =
+        calculateCLI
+        (
+            statistics.wordCharacters,
+            statistics.words,
+            statistics.sentences
+        );
+
+    return snapshot;
 }
 
 void DocumentStatisticsPrivate::updateBlockStatistics(QTextBlock &block)
@@ -241,149 +434,246 @@ void DocumentStatisticsPrivate::updateBlockStatistics(QTextBlock &block)
     TextBlockData *blockData = (TextBlockData *) block.userData();
 
     if (nullptr == blockData) {
-        blockData = new TextBlockData(document, block);
+        blockData = new TextBlockData(document);
         block.setUserData(blockData);
     }
 
-    int oldWordCount = blockData->wordCount;
-    int oldLixLongWordCount = blockData->lixLongWordCount;
-    int oldAlphaNumCharCount = blockData->alphaNumericCharacterCount;
+    // Difference between the block's statistics before and after
+    // recounting.
+    BlockStatistics delta;
+    delta -= blockStatistics(block);
+
+    blockData->sentenceCount =
+        SentenceSegmenter::countSentences
+        (
+            block.text(),
+            SentenceSegmenter::boundaries(block)
+        );
+    blockData->blankLine = (block.text().trimmed().length() <= 0);
+
+    delta += blockStatistics(block);
+    applyBlockDelta(block, delta);
+}
 
-    countWords
-    (
-        block.text(),
-        blockData->wordCount,
-        blockData->lixLongWordCount,
-        blockData->alphaNumericCharacterCount
-    );
+void DocumentStatisticsPrivate::applyBlockDelta
+(
+    const QTextBlock &block,
+    const BlockStatistics &delta
+)
+{
+    wordCount += delta.words;
+    lixLongWordCount += delta.longWords;
+    wordCharacterCount += delta.wordCharacters;
+    sentenceCount += delta.sentences;
+    paragraphCount += delta.paragraphs;
+
+    // The index can only be updated in place if no blocks were added or
+    // removed since it was built.
+    //
+    if (blockIndexValid && (document->blockCount() == blockIndex.size())) {
+        blockIndex.add(block.blockNumber(), delta);
+    } else {
+        blockIndexValid = false;
+    }
+}
+
+void DocumentStatisticsPrivate::startWordCount()
+{
+    Q_Q(DocumentStatistics);
 
-    wordCount += blockData->wordCount - oldWordCount;
-    lixLongWordCount += blockData->lixLongWordCount - oldLixLongWordCount;
-    wordCharacterCount += blockData->alphaNumericCharacterCount - oldAlphaNumCharCount;
+    QVector<QTextBlock> blocks;
+    QVector<uint> keys;
+    QStringList texts;
+    QSet<int> blockNumbers;
 
-    int oldSentenceCount = blockData->sentenceCount;
-    blockData->sentenceCount = countSentences(block.text());
-    sentenceCount += blockData->sentenceCount - oldSentenceCount;
+    wordCountScheduled = false;
 
-    if (blockData->blankLine) {
-        if (block.text().trimmed().length() > 0) {
-            blockData->blankLine = false;
-            paragraphCount++;
+    // Snapshot the prose of the blocks, which only the GUI thread may read.
+    foreach (const QTextBlock &block, wordCountBlocks) {
+        if (block.isValid() && !blockNumbers.contains(block.blockNumber())) {
+            QString prose = TextBlockData::proseText(block);
+
+            blockNumbers.insert(block.blockNumber());
+            blocks.append(block);
+            keys.append(qHash(prose));
+            texts.append(prose);
         }
-    } else if (block.text().trimmed().length() <= 0) {
-        blockData->blankLine = true;
-        paragraphCount--;
     }
+
+    wordCountBlocks.clear();
+
+    if (blocks.isEmpty()) {
+        checkWordCountSettled();
+        return;
+    }
+
+    runningWordCounts++;
+
+    QFutureWatcher<QVector<BlockStatistics>> *watcher =
+        new QFutureWatcher<QVector<BlockStatistics>>(q);
+
+    q->connect
+    (
+        watcher,
+        &QFutureWatcher<QVector<BlockStatistics>>::finished,
+        [this, watcher, blocks, keys]() {
+            onWordCountFinished(blocks, keys, watcher->result());
+            watcher->deleteLater();
+        }
+    );
+
+    watcher->setFuture
+    (
+        QtConcurrent::run
+        (
+            &DocumentStatisticsPrivate::countWords,
+            wordSegmenter,
+            texts
+        )
+    );
 }
 
-void DocumentStatisticsPrivate::countWords
+void DocumentStatisticsPrivate::onWordCountFinished
 (
-    const QString &text,
-    int &words,
-    int &lixLongWords,
-    int &alphaNumericCharacters
+    const QVector<QTextBlock> &blocks,
+    const QVector<uint> &keys,
+    const QVector<BlockStatistics> &counts
 )
 {
-    bool inWord = false;
-    int separatorCount = 0;
-    int wordLen = 0;
+    bool changed = false;
 
-    words = 0;
-    lixLongWords = 0;
-    alphaNumericCharacters = 0;
+    runningWordCounts--;
 
-    for (int i = 0; i < text.length(); i++) {
-        if (text[i].isLetterOrNumber()) {
-            inWord = true;
-            separatorCount = 0;
-            wordLen++;
-            alphaNumericCharacters++;
-        } else if (text[i].isSpace() && inWord) {
-            inWord = false;
-            words++;
+    for (int i = 0; i < blocks.size(); i++) {
+        QTextBlock block = blocks[i];
 
-            if (separatorCount > 0) {
-                wordLen--;
-                alphaNumericCharacters--;
-            }
+        if (!block.isValid()) {
+            continue;
+        }
+
+        TextBlockData *blockData = (TextBlockData *) block.userData();
 
-            separatorCount = 0;
+        // Discard counts for prose that has changed since, for which a
+        // newer count has been requested.
+        if
+        (
+            (nullptr == blockData)
+            || (keys[i] != qHash(blockData->proseText(block.text())))
+        ) {
+            continue;
+        }
 
-            if (wordLen > 6) {
-                lixLongWords++;
-            }
+        BlockStatistics delta;
+        delta -= blockStatistics(block);
 
-            wordLen = 0;
+        blockData->wordCount = counts[i].words;
+        blockData->lixLongWordCount = counts[i].longWords;
+        blockData->alphaNumericCharacterCount = counts[i].wordCharacters;
+
+        delta += blockStatistics(block);
+        applyBlockDelta(block, delta);
+        changed = true;
+    }
+
+    if (changed) {
+        // Don't replace the statistics of selected text.
+        if (textSelected) {
+            StatisticsSnapshot selection = pendingSnapshot;
+            selection.totalWordCount = wordCount;
+            publish(selection);
         } else {
-            // This is to handle things like double dashes (`--`)
-            // that separate words, while still counting hyphenated
-            // words as a single word.
-            //
-            separatorCount++;
-
-            if (inWord) {
-                if (separatorCount > 1) {
-                    separatorCount = 0;
-                    inWord = false;
-                    words++;
-                    wordLen--;
-                    alphaNumericCharacters--;
-
-                    if (wordLen > 6) {
-                        lixLongWords++;
-                    }
-
-                    wordLen = 0;
-                } else {
-                    wordLen++;
-                    alphaNumericCharacters++;
-                }
-            }
+            updateStatistics();
         }
     }
 
-    if (inWord) {
-        words++;
+    checkWordCountSettled();
+}
 
-        if (separatorCount > 0) {
-            wordLen--;
-            alphaNumericCharacters--;
-        }
+void DocumentStatisticsPrivate::checkWordCountSettled()
+{
+    Q_Q(DocumentStatistics);
 
-        if (wordLen > 6) {
-            lixLongWords++;
-        }
+    if (!wordCountScheduled && (runningWordCounts <= 0)) {
+        emit q->wordCountSettled(wordCount);
     }
 }
 
-int DocumentStatisticsPrivate::countSentences(const QString &text)
+QVector<BlockStatistics> DocumentStatisticsPrivate::countWords
+(
+    const WordSegmenter &segmenter,
+    const QStringList &texts
+)
 {
-    int count = 0;
+    QVector<BlockStatistics> counts(texts.size());
+
+    for (int i = 0; i < texts.size(); i++) {
+        segmenter.countWords
+        (
+            texts[i],
+            counts[i].words,
+            counts[i].longWords,
+            counts[i].wordCharacters
+        );
+    }
 
-    QString trimmedText = text.trimmed();
+    return counts;
+}
 
-    if (trimmedText.length() > 0) {
-        QTextBoundaryFinder boundaryFinder(QTextBoundaryFinder::Sentence, trimmedText);
-        int nextSentencePos = 0;
+void DocumentStatisticsPrivate::updateBlockIndex()
+{
+    if (blockIndexValid && (document->blockCount() == blockIndex.size())) {
+        return;
+    }
 
-        boundaryFinder.setPosition(0);
+    QVector<BlockStatistics> values;
+    values.reserve(document->blockCount());
 
-        while (nextSentencePos >= 0) {
-            int oldPos = nextSentencePos;
-            nextSentencePos = boundaryFinder.toNextBoundary();
+    for (QTextBlock block = document->begin(); block.isValid(); block = block.next()) {
+        values.append(blockStatistics(block));
+    }
 
-            if
-            (
-                ((nextSentencePos - oldPos) > 1) ||
-                (((nextSentencePos - oldPos) > 0) &&
-                 !trimmedText[oldPos].isSpace())
-            ) {
-                count++;
-            }
-        }
+    blockIndex.build(values);
+    blockIndexValid = true;
+}
+
+BlockStatistics DocumentStatisticsPrivate::countText
+(
+    const QString &text,
+    const QString &prose
+)
+{
+    BlockStatistics statistics;
+
+    wordSegmenter.countWords
+    (
+        prose,
+        statistics.words,
+        statistics.longWords,
+        statistics.wordCharacters
+    );
+
+    statistics.sentences = SentenceSegmenter::countSentences(text);
+    return statistics;
+}
+
+BlockStatistics DocumentStatisticsPrivate::blockStatistics(const QTextBlock &block)
+{
+    return blockStatistics((const TextBlockData *) block.userData());
+}
+
+BlockStatistics DocumentStatisticsPrivate::blockStatistics(const TextBlockData *blockData)
+{
+    BlockStatistics statistics;
+
+    if (nullptr != blockData) {
+        statistics.words = blockData->wordCount;
+        statistics.longWords = blockData->lixLongWordCount;
+        statistics.wordCharacters = blockData->alphaNumericCharacterCount;
+        statistics.sentences = blockData->sentenceCount;
+        statistics.paragraphs = blockData->blankLine ? 0 : 1;
     }
 
-    return count;
+    return statistics;
 }
 
 int DocumentStatisticsPrivate::calculatePageCount(int words)
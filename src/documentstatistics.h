@@ -24,6 +24,7 @@
 #include <QScopedPointer>
 
 #include "markdowndocument.h"
+#include "statisticssnapshot.h"
 #include "textblockdata.h"
 
 namespace ghostwriter
@@ -53,58 +54,33 @@ public:
      */
     int wordCount() const;
 
-signals:
-    /**
-     * Emitted when word count changes.  May be word count
-     * of entire document or of selected text.
-     */
-    void wordCountChanged(int value);
-
     /**
-     * Emitted when word count changes.  The value is
-     * always the word count of the entire document.
+     * Returns true if word counts are queued or in progress in the
+     * background, in which case wordCountSettled() will be emitted.
      */
-    void totalWordCountChanged(int value);
+    bool isCountingWords() const;
 
     /**
-     * Emitted when character count changes.
+     * Sets the minimum interval in milliseconds between two
+     * statisticsChanged() signals.  Changes made in between are coalesced
+     * into one snapshot.  The default is one display frame.
      */
-    void characterCountChanged(int value);
-
-    /**
-     * Emitted when paragraph count changes.
-     */
-    void paragraphCountChanged(int value);
-
-    /**
-     * Emitted when sentence count changes.
-     */
-    void sentenceCountChanged(int value);
-
-    /**
-     * Emitted when page count changes.
-     */
-    void pageCountChanged(int value);
-
-    /**
-     * Emitted when complex word percentage changes.
-     */
-    void complexWordsChanged(int percentage);
-
-    /**
-     * Emitted when reading time changes.
-     */
-    void readingTimeChanged(int minutes);
+    void setUpdateInterval(int msecs);
 
+signals:
     /**
-     * Emitted when LIX reading ease value changes.
+     * Emitted when any of the statistics change.  The snapshot holds
+     * the statistics of either the entire document or the selected text.
      */
-    void lixReadingEaseChanged(int value);
+    void statisticsChanged(const StatisticsSnapshot &snapshot);
 
     /**
-     * Emitted when Coleman-Liau readability index (CLI) changes.
+     * Emitted once all the word counts in progress in the background
+     * have been applied, with the word count of the entire document.
+     * It isn't emitted for the intermediate counts taken while a
+     * document is loaded or reparsed.
      */
-    void readabilityIndexChanged(int value);
+    void wordCountSettled(int totalWordCount);
 
 public slots:
     /**
@@ -126,7 +102,12 @@ public slots:
 
 protected slots:
     void onTextChanged(int position, int charsRemoved, int charsAdded);
-    void onTextBlockRemoved(const QTextBlock &blockData);
+    void onTextBlockRemoved(const TextBlockData *blockData);
+    void onTextBlockProseChanged(const QTextBlock &block);
+
+private slots:
+    void startWordCount();
+    void publishStatistics();
 
 private:
     QScopedPointer<DocumentStatisticsPrivate> d_ptr;
@@ -33,7 +33,8 @@ public:
           EASY_READING_EASE_STR(QObject::tr("Easy")),
           MEDIUM_READING_EASE_STR(QObject::tr("Standard")),
           DIFFICULT_READING_EASE_STR(QObject::tr("Difficult")),
-          VERY_DIFFICULT_READING_EASE_STR(QObject::tr("Very Difficult"))
+          VERY_DIFFICULT_READING_EASE_STR(QObject::tr("Very Difficult")),
+          snapshotValid(false)
     {
         ;
     }
@@ -62,6 +63,10 @@ public:
 
     // Coleman-Liau readability index (CLI)
     QLabel *cliLabel;
+
+    // Last snapshot displayed by setStatistics().
+    StatisticsSnapshot snapshot;
+    bool snapshotValid;
 };
 
 DocumentStatisticsWidget::DocumentStatisticsWidget(QWidget *parent)
@@ -87,6 +92,53 @@ DocumentStatisticsWidget::~DocumentStatisticsWidget()
 
 }
 
+void DocumentStatisticsWidget::setStatistics(const StatisticsSnapshot &snapshot)
+{
+    Q_D(DocumentStatisticsWidget);
+
+    const StatisticsSnapshot &last = d->snapshot;
+    bool all = !d->snapshotValid;
+
+    if (all || (snapshot.wordCount != last.wordCount)) {
+        setWordCount(snapshot.wordCount);
+    }
+
+    if (all || (snapshot.characterCount != last.characterCount)) {
+        setCharacterCount(snapshot.characterCount);
+    }
+
+    if (all || (snapshot.sentenceCount != last.sentenceCount)) {
+        setSentenceCount(snapshot.sentenceCount);
+    }
+
+    if (all || (snapshot.paragraphCount != last.paragraphCount)) {
+        setParagraphCount(snapshot.paragraphCount);
+    }
+
+    if (all || (snapshot.pageCount != last.pageCount)) {
+        setPageCount(snapshot.pageCount);
+    }
+
+    if (all || (snapshot.complexWords != last.complexWords)) {
+        setComplexWords(snapshot.complexWords);
+    }
+
+    if (all || (snapshot.readingTime != last.readingTime)) {
+        setReadingTime(snapshot.readingTime);
+    }
+
+    if (all || (snapshot.lixReadingEase != last.lixReadingEase)) {
+        setLixReadingEase(snapshot.lixReadingEase);
+    }
+
+    if (all || (snapshot.readabilityIndex != last.readabilityIndex)) {
+        setReadabilityIndex(snapshot.readabilityIndex);
+    }
+
+    d->snapshot = snapshot;
+    d->snapshotValid = true;
+}
+
 void DocumentStatisticsWidget::setWordCount(int value)
 {
     Q_D(DocumentStatisticsWidget);
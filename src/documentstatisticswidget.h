@@ -23,6 +23,7 @@
 #include <QScopedPointer>
 
 #include "abstractstatisticswidget.h"
+#include "statisticssnapshot.h"
 
 namespace ghostwriter
 {
@@ -47,6 +48,12 @@ public:
     virtual ~DocumentStatisticsWidget();
 
 public slots:
+    /**
+     * Displays the given statistics, updating only the values that
+     * differ from the previously displayed snapshot.
+     */
+    void setStatistics(const StatisticsSnapshot &snapshot);
+
     /**
      * Sets the word count to display.
      */
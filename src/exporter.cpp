@@ -21,6 +21,7 @@
 #include <QString>
 #include <QStringList>
 #include <QObject>
+#include <QThreadStorage>
 
 #include "exporter.h"
 
@@ -29,6 +30,9 @@
 
 namespace ghostwriter
 {
+// Exporters are shared between threads, so each thread has its own check.
+static QThreadStorage<Exporter::CancellationCheck> cancellationChecks;
+
 Exporter::Exporter(const QString &name)
     : m_smartTypographyEnabled(false), m_name(name)
 {
@@ -68,5 +72,35 @@ void Exporter::exportToHtml(const QString &text, QString &html)
            QObject::tr("Export to HTML is not supported with this processor.") +
            QString("</b></center>)");
 }
+
+void Exporter::setCancellationCheck(const CancellationCheck &check)
+{
+    cancellationChecks.setLocalData(check);
+}
+
+bool Exporter::isCancelled()
+{
+    if (!cancellationChecks.hasLocalData()) {
+        return false;
+    }
+
+    CancellationCheck check = cancellationChecks.localData();
+
+    return check && check();
+}
+
+void Exporter::exportToHtmlBlocks
+(
+    const QString &text,
+    QVector<HtmlBlock> &blocks
+)
+{
+    QString html;
+
+    exportToHtml(text, html);
+
+    blocks.clear();
+    blocks.append(HtmlBlock(html, 1, text.count('\n') + 1));
+}
 } // namespace ghostwriter
 
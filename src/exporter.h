@@ -20,10 +20,14 @@
 #ifndef _EXPORTER_H
 #define _EXPORTER_H
 
+#include <functional>
+
 #include <QString>
 #include <QList>
+#include <QVector>
 
 #include "exportformat.h"
+#include "htmlblock.h"
 
 namespace ghostwriter
 {
@@ -35,6 +39,12 @@ namespace ghostwriter
 class Exporter
 {
 public:
+    /**
+     * Function returning true if the export in progress is no longer
+     * wanted.
+     */
+    typedef std::function<bool()> CancellationCheck;
+
     /**
      * Constructor.  Takes unique name (that is, unique within the scope of
      * the application) of the exporter as parameter.
@@ -86,6 +96,19 @@ public:
      */
     virtual void exportToHtml(const QString &text, QString &html);
 
+    /**
+     * Override this method to transform the given text into HTML split
+     * into its top-level blocks, so that the Live HTML Preview can update
+     * only the blocks that changed.  By default, this method calls
+     * exportToHtml() and returns its result as a single block spanning
+     * the whole text.
+     */
+    virtual void exportToHtmlBlocks
+    (
+        const QString &text,
+        QVector<HtmlBlock> &blocks
+    );
+
     /**
      * Implement this method to export the given text to a file of the
      * given format.  Set the err variable to an error string if
@@ -106,6 +129,20 @@ public:
         QString &err
     ) = 0;
 
+    /**
+     * Sets the check that exports on the calling thread use to find out
+     * whether to give up early, such as when a newer preview supersedes
+     * the one being rendered.  Pass in an empty function to clear it.
+     */
+    static void setCancellationCheck(const CancellationCheck &check);
+
+    /**
+     * Returns true if the export in progress on the calling thread should
+     * be abandoned, according to the check set with
+     * setCancellationCheck().
+     */
+    static bool isCancelled();
+
 protected:
     /*
     * Implementors of this class should add their supported export formats
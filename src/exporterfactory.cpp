@@ -205,6 +205,7 @@ ExporterFactory::ExporterFactory()
         }
 
         exporter->setSmartTypographyOffArgument("--nosmart");
+        exporter->setKeyValueMetadataEnabled(true);
         exporter->setHtmlRenderCommand(QString("multimarkdown %1 -t html")
                                        .arg(CommandLineExporter::SMART_TYPOGRAPHY_ARG));
         exporter->addFileExportCommand
@@ -304,6 +305,25 @@ ExporterFactory::ExporterFactory()
         d->fileExporters.append(exporter);
         d->htmlExporters.append(exporter);
     }
+
+    // Long-lived render servers for the Live HTML Preview are opt-in,
+    // configured per exporter name.  See
+    // CommandLineExporter::setHtmlRenderServerCommand().
+    //
+    QSettings settings;
+    settings.beginGroup("PreviewServers");
+
+    foreach (Exporter *htmlExporter, d->htmlExporters) {
+        CommandLineExporter *commandLineExporter =
+            dynamic_cast<CommandLineExporter *>(htmlExporter);
+        QString command = settings.value(htmlExporter->name()).toString();
+
+        if ((nullptr != commandLineExporter) && !command.isEmpty()) {
+            commandLineExporter->setHtmlRenderServerCommand(command);
+        }
+    }
+
+    settings.endGroup();
 }
 
 QList<int> ExporterFactoryPrivate::extractVersionNumber(const QString &command) const
@@ -381,6 +401,11 @@ void ExporterFactoryPrivate::addPandocExporter
         exporter->setSmartTypographyOnArgument(" --smart");
     }
 
+    // Pandoc reads MultiMarkdown metadata with its mmd_title_block
+    // extension, which is enabled for the MultiMarkdown flavor.
+    //
+    exporter->setKeyValueMetadataEnabled(inputFormat.startsWith("markdown_mmd"));
+
     exporter->setHtmlRenderCommand
     (
         QString("pandoc --mathml -f ") +
@@ -0,0 +1,126 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef FENWICK_TREE_H
+#define FENWICK_TREE_H
+
+#include <QVector>
+
+namespace ghostwriter
+{
+/**
+ * Fenwick tree (binary indexed tree) over a sequence of values, which
+ * supports updating a single value and summing any range of values in
+ * O(log n) time.  The value type must be default constructible to zero
+ * and support the += and -= operators.
+ */
+template <class T>
+class FenwickTree
+{
+public:
+    /**
+     * Constructor.  Creates an empty tree.
+     */
+    FenwickTree()
+    {
+        ;
+    }
+
+    /**
+     * Replaces the contents of the tree with the given values, in O(n)
+     * time.
+     */
+    void build(const QVector<T> &values)
+    {
+        tree.fill(T(), values.size() + 1);
+
+        for (int i = 1; i < tree.size(); i++) {
+            tree[i] += values[i - 1];
+
+            int parent = i + (i & -i);
+
+            if (parent < tree.size()) {
+                tree[parent] += tree[i];
+            }
+        }
+    }
+
+    /**
+     * Removes all values from the tree.
+     */
+    void clear()
+    {
+        tree.clear();
+    }
+
+    /**
+     * Returns the number of values in the tree.
+     */
+    int size() const
+    {
+        return (tree.size() > 0) ? (tree.size() - 1) : 0;
+    }
+
+    /**
+     * Adds the given delta to the value at the given index.
+     */
+    void add(int index, const T &delta)
+    {
+        for (int i = index + 1; i < tree.size(); i += (i & -i)) {
+            tree[i] += delta;
+        }
+    }
+
+    /**
+     * Returns the sum of the first count values.
+     */
+    T prefixSum(int count) const
+    {
+        T sum = T();
+
+        for (int i = qMin(count, size()); i > 0; i -= (i & -i)) {
+            sum += tree[i];
+        }
+
+        return sum;
+    }
+
+    /**
+     * Returns the sum of the values from index first to index last,
+     * inclusive.
+     */
+    T rangeSum(int first, int last) const
+    {
+        if (last < first) {
+            return T();
+        }
+
+        T sum = prefixSum(last + 1);
+        sum -= prefixSum(first);
+        return sum;
+    }
+
+private:
+    // One-based, with index 0 unused.
+    QVector<T> tree;
+};
+} // namespace ghostwriter
+
+#endif
@@ -0,0 +1,53 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef HTML_BLOCK_H
+#define HTML_BLOCK_H
+
+#include <QString>
+
+namespace ghostwriter
+{
+/**
+ * HTML rendered for one top-level block of a Markdown document, along
+ * with the span of source lines it was rendered from.  Line numbers are
+ * one-based and inclusive.
+ */
+struct HtmlBlock
+{
+    HtmlBlock()
+        : startLine(0), endLine(0)
+    {
+        ;
+    }
+
+    HtmlBlock(const QString &html, int startLine, int endLine)
+        : html(html), startLine(startLine), endLine(endLine)
+    {
+        ;
+    }
+
+    QString html;
+    int startLine;
+    int endLine;
+};
+} // namespace ghostwriter
+
+#endif // HTML_BLOCK_H
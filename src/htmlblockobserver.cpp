@@ -0,0 +1,189 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+
+#include "htmlblockobserver.h"
+
+namespace ghostwriter
+{
+HtmlBlockObserver::HtmlBlockObserver(QObject *parent)
+    : QObject(parent),
+      mHtmlIncluded(true)
+{
+    ;
+}
+
+HtmlBlockObserver::~HtmlBlockObserver()
+{
+    ;
+}
+
+void HtmlBlockObserver::setBlocks(const QVector<HtmlBlock> &blocks)
+{
+    QStringList keys;
+    QHash<uint, int> occurrences;
+
+    keys.reserve(blocks.size());
+
+    // Identical blocks (such as horizontal rules) are told apart by
+    // their order of occurrence.
+    foreach (const HtmlBlock &block, blocks) {
+        uint hash = qHash(block.html);
+        int occurrence = occurrences.value(hash, 0);
+
+        occurrences.insert(hash, occurrence + 1);
+        keys.append(QString("%1-%2").arg(hash, 0, 16).arg(occurrence));
+    }
+
+    // Only the blocks between the unchanged blocks at the start and at
+    // the end of the document need to be patched.
+    //
+    int start = 0;
+
+    while
+    (
+        (start < keys.size())
+        && (start < mKeys.size())
+        && (keys[start] == mKeys[start])
+        && (blocks[start].startLine == mBlocks[start].startLine)
+        && (blocks[start].endLine == mBlocks[start].endLine)
+    ) {
+        start++;
+    }
+
+    int oldEnd = mKeys.size();
+    int newEnd = keys.size();
+    int shift = 0;
+
+    if ((oldEnd > start) && (newEnd > start)) {
+        shift = blocks[newEnd - 1].startLine - mBlocks[oldEnd - 1].startLine;
+    }
+
+    // The unchanged blocks at the end only keep their place in the page
+    // if they all moved by the same number of lines, which is the case
+    // unless several edits happened between two renders.
+    //
+    while
+    (
+        (oldEnd > start)
+        && (newEnd > start)
+        && (keys[newEnd - 1] == mKeys[oldEnd - 1])
+        && ((blocks[newEnd - 1].startLine - mBlocks[oldEnd - 1].startLine) == shift)
+        && ((blocks[newEnd - 1].endLine - mBlocks[oldEnd - 1].endLine) == shift)
+    ) {
+        oldEnd--;
+        newEnd--;
+    }
+
+    mBlocks = blocks;
+    mKeys = keys;
+    mPreviousHtml = mHtml;
+    mHtml.clear();
+
+    for (int i = 0; i < keys.size(); i++) {
+        mHtml.insert(keys[i], blocks[i].html);
+    }
+
+    if ((oldEnd > start) || (newEnd > start) || (0 != shift)) {
+        emit blocksPatched(patch(start, oldEnd - start, newEnd - start, shift));
+    }
+}
+
+void HtmlBlockObserver::setHtmlIncluded(bool included)
+{
+    mHtmlIncluded = included;
+}
+
+bool HtmlBlockObserver::blockHtml(const QString &key, QString &html) const
+{
+    if (mHtml.contains(key)) {
+        html = mHtml.value(key);
+    } else if (mPreviousHtml.contains(key)) {
+        html = mPreviousHtml.value(key);
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+QStringList HtmlBlockObserver::linkedUrls() const
+{
+    static const QRegularExpression linkRegex("\\b(?:src|href)\\s*=\\s*\"([^\"]*)\"");
+
+    QStringList urls;
+
+    foreach (const QString &html, mHtml) {
+        QRegularExpressionMatchIterator matches = linkRegex.globalMatch(html);
+
+        while (matches.hasNext()) {
+            QString url = matches.next().captured(1);
+            url.replace("&amp;", "&");
+            urls.append(url);
+        }
+    }
+
+    return urls;
+}
+
+void HtmlBlockObserver::requestBlocks()
+{
+    // The page's blocks are unknown, so ask it to remove all of them.
+    emit blocksPatched(patch(0, -1, mBlocks.size(), 0));
+}
+
+void HtmlBlockObserver::setTopLine(int line)
+{
+    emit topLineChanged(line);
+}
+
+QString HtmlBlockObserver::patch(int start, int remove, int count, int shift) const
+{
+    QJsonArray insert;
+
+    for (int i = start; i < (start + count); i++) {
+        QJsonObject block;
+
+        block.insert("key", mKeys[i]);
+        block.insert("line", mBlocks[i].startLine);
+        block.insert("end", mBlocks[i].endLine);
+
+        if (mHtmlIncluded || (remove < 0)) {
+            block.insert("html", mBlocks[i].html);
+        }
+
+        insert.append(block);
+    }
+
+    QJsonObject patch;
+
+    patch.insert("start", start);
+    patch.insert("remove", remove);
+    patch.insert("insert", insert);
+    patch.insert("shift", shift);
+
+    return QString::fromUtf8(QJsonDocument(patch).toJson(QJsonDocument::Compact));
+}
+} // namespace ghostwriter
@@ -0,0 +1,131 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef HTMLBLOCKOBSERVER_H
+#define HTMLBLOCKOBSERVER_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "htmlblock.h"
+
+namespace ghostwriter
+{
+/**
+ * Observer pattern for the HTML blocks of a rendered document.  Used in
+ * notifying web channel in QtWebEngine (Chromium) of which blocks were
+ * inserted, removed, or changed, so that the page only needs to patch
+ * those blocks instead of replacing its entire contents.
+ *
+ * Each block is identified by a key made from the hash of its HTML, so
+ * that blocks that did not change keep their keys even when they move.
+ */
+class HtmlBlockObserver : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Constructor.
+     */
+    explicit HtmlBlockObserver(QObject *parent = nullptr);
+
+    /**
+     * Destructor.
+     */
+    virtual ~HtmlBlockObserver();
+
+    /**
+     * Sets the blocks of HTML to display.  Emits blocksPatched() with
+     * the blocks that differ from the ones previously set, if any.
+     */
+    void setBlocks(const QVector<HtmlBlock> &blocks);
+
+    /**
+     * Sets whether patches include the HTML of the blocks they insert.
+     * If not, the web page fetches it with blockHtml() by key.  Patches
+     * replacing all blocks always include their HTML.  The default is true.
+     */
+    void setHtmlIncluded(bool included);
+
+    /**
+     * Gets the HTML of the block having the given key.  Blocks from the
+     * previous call to setBlocks() are also found, since the web page may
+     * still be catching up to them.  Returns false if there is no such
+     * block.
+     */
+    bool blockHtml(const QString &key, QString &html) const;
+
+    /**
+     * Returns the URLs referenced by the src and href attributes in the
+     * HTML of the current blocks, as written.
+     */
+    QStringList linkedUrls() const;
+
+    /**
+     * Called from the web page once its web channel is ready.  Emits
+     * blocksPatched() to replace all of the page's blocks with the
+     * current ones.
+     */
+    Q_INVOKABLE void requestBlocks();
+
+    /**
+     * Called from the web page when the user scrolls it, with the source
+     * line of the HTML now at the top of the page.  Emits topLineChanged().
+     */
+    Q_INVOKABLE void setTopLine(int line);
+
+signals:
+    /**
+     * Emitted when blocks change.  The patch is a JSON object with the
+     * index of the first changed block ("start"), the number of blocks
+     * to remove from that index ("remove"), and the list of blocks to
+     * insert in their place ("insert"), each having a "key", "html" (see
+     * setHtmlIncluded()), and the first and last source lines it was
+     * rendered from ("line" and "end").  The source lines of the blocks following the inserted
+     * ones are offset by "shift".
+     */
+    void blocksPatched(const QString &patch);
+
+    /**
+     * Emitted when the user scrolls the web page to the given source line.
+     */
+    void topLineChanged(int line);
+
+private:
+    QVector<HtmlBlock> mBlocks;
+    QStringList mKeys;
+    QHash<QString, QString> mHtml;
+    QHash<QString, QString> mPreviousHtml;
+    bool mHtmlIncluded;
+
+    /*
+    * Returns the JSON patch replacing the remove blocks at index start
+    * with count of the current blocks, starting from the same index, and
+    * offsetting the source lines of the blocks that follow by shift.
+    */
+    QString patch(int start, int remove, int count, int shift) const;
+};
+} // namespace ghostwriter
+
+#endif // HTMLBLOCKOBSERVER_H
@@ -27,10 +27,13 @@
 #include <QDesktopServices>
 #include <QtConcurrentRun>
 #include <QFuture>
+#include <QThreadPool>
 #include <QWebChannel>
 
 #include "exporter.h"
+#include "htmlblockobserver.h"
 #include "htmlpreview.h"
+#include "previewschemehandler.h"
 #include "sandboxedwebpage.h"
 #include "stringobserver.h"
 
@@ -42,9 +45,16 @@ class HtmlPreviewPrivate
 
 public:
     HtmlPreviewPrivate(HtmlPreview *q_ptr)
-        : q_ptr(q_ptr)
+        : q_ptr(q_ptr),
+          revision(0),
+          schemeHandler(&livePreviewBlocks)
     {
-        ;
+        // Render one revision at a time, without competing with other
+        // work in the global thread pool.  Keep the thread alive, since
+        // exporters may keep per-thread state such as a render server.
+        //
+        previewPool.setMaxThreadCount(1);
+        previewPool.setExpiryTimeout(-1);
     }
 
     ~HtmlPreviewPrivate()
@@ -55,17 +65,22 @@ public:
     HtmlPreview *q_ptr;
 
     MarkdownDocument *document;
-    bool updateInProgress;
-    bool updateAgain;
-    StringObserver livePreviewHtml;
+
+    // Revision of the most recently requested preview.  Renders of older
+    // revisions are skipped if they haven't started yet, and their
+    // results are discarded otherwise.
+    QAtomicInt revision;
+    QThreadPool previewPool;
+
+    HtmlBlockObserver livePreviewBlocks;
+    PreviewSchemeHandler schemeHandler;
     StringObserver styleSheet;
     QString baseUrl;
     QRegularExpression headingTagExp;
     Exporter *exporter;
     QString wrapperHtml;
-    QFutureWatcher<QString> *futureWatcher;
 
-    void onHtmlReady();
+    void onHtmlReady(int revision, const QVector<HtmlBlock> &blocks);
     void onLoadFinished(bool ok);
 
     /**
@@ -75,13 +90,18 @@ public:
      */
     void updateBaseDir();
     /*
-    * Sets the HTML contents to display, and creates a backup of the old
-    * HTML for diffing to scroll to the first difference whenever
-    * updatePreview() is called.
+    * Sets the HTML blocks to display.  Only the blocks that changed
+    * since the last call are sent to the web page.
     */
-    void setHtmlContent(const QString &html);
+    void setHtmlContent(const QVector<HtmlBlock> &blocks);
 
-    QString exportToHtml(const QString &text, Exporter *exporter) const;
+    static QVector<HtmlBlock> exportToHtml
+    (
+        const QString &text,
+        Exporter *exporter,
+        int revision,
+        const QAtomicInt *latestRevision
+    );
 };
 
 HtmlPreview::HtmlPreview
@@ -95,12 +115,9 @@ HtmlPreview::HtmlPreview
     Q_D(HtmlPreview);
     
     d->document = document;
-    d->updateInProgress = false;
-    d->updateAgain = false;
     d->exporter = exporter;
 
     d->baseUrl = "";
-    d->livePreviewHtml.setText("");
     d->styleSheet.setText("");
 
     this->setPage(new SandboxedWebPage(this));
@@ -114,10 +131,17 @@ HtmlPreview::HtmlPreview
     this->page()->action(QWebEnginePage::OpenLinkInNewWindow)->setVisible(false);
     this->page()->action(QWebEnginePage::ViewSource)->setVisible(false);
     this->page()->action(QWebEnginePage::SavePage)->setVisible(false);
-    QWebEngineProfile::defaultProfile()->setHttpCacheType(QWebEngineProfile::NoCache);
-    QWebEngineProfile::defaultProfile()->clearHttpCache();
+    QWebEngineProfile::defaultProfile()->setHttpCacheType(QWebEngineProfile::MemoryHttpCache);
     QWebEngineProfile::defaultProfile()->clearAllVisitedLinks();
 
+    // Serve block HTML and local files through the scheme handler, so
+    // that the web channel only carries what changed.
+    //
+    if (PreviewSchemeHandler::isAvailable()) {
+        this->page()->profile()->installUrlSchemeHandler(PreviewSchemeHandler::SCHEME, &d->schemeHandler);
+        d->livePreviewBlocks.setHtmlIncluded(false);
+    }
+
     this->connect
     (
         this,
@@ -129,16 +153,6 @@ HtmlPreview::HtmlPreview
 
     d->headingTagExp.setPattern("^[Hh][1-6]$");
 
-    d->futureWatcher = new QFutureWatcher<QString>(this);
-    this->connect
-    (
-        d->futureWatcher,
-        &QFutureWatcher<QString>::finished,
-        [d]() {
-            d->onHtmlReady();
-        }
-    );
-
     this->connect
     (
         document,
@@ -156,7 +170,14 @@ HtmlPreview::HtmlPreview
 
     QWebChannel *channel = new QWebChannel(this);
     channel->registerObject(QStringLiteral("stylesheet"), &d->styleSheet);
-    channel->registerObject(QStringLiteral("livepreviewcontent"), &d->livePreviewHtml);
+    channel->registerObject(QStringLiteral("livepreviewcontent"), &d->livePreviewBlocks);
+    this->connect
+    (
+        &d->livePreviewBlocks,
+        &HtmlBlockObserver::topLineChanged,
+        this,
+        &HtmlPreview::lineNavigated
+    );
     this->page()->setWebChannel(channel);
 
     QFile wrapperHtmlFile(":/resources/preview.html");
@@ -177,8 +198,9 @@ HtmlPreview::~HtmlPreview()
 {
     Q_D(HtmlPreview);
     
-    // Wait for thread to finish if in the middle of updating the preview.
-    d->futureWatcher->waitForFinished();
+    // Skip any renders still queued, and wait for the one in progress.
+    d->revision.fetchAndAddOrdered(1);
+    d->previewPool.waitForDone();
 }
 
 void HtmlPreview::contextMenuEvent(QContextMenuEvent *event)
@@ -191,33 +213,48 @@ void HtmlPreview::updatePreview()
 {
     Q_D(HtmlPreview);
     
-    if (d->updateInProgress) {
-        d->updateAgain = true;
+    // Supersede any render still in progress.
+    int revision = d->revision.fetchAndAddOrdered(1) + 1;
+
+    if (!this->isVisible()) {
         return;
     }
 
-    if (this->isVisible()) {
-        // Some markdown processors don't handle empty text very well
-        // and will err.  Thus, only pass in text from the document
-        // into the markdown processor if the text isn't empty or null.
-        //
-        if (d->document->isEmpty()) {
-            d->setHtmlContent("");
-        } else if (nullptr != d->exporter) {
-            QString text = d->document->toPlainText();
-
-            if (!text.isNull() && !text.isEmpty()) {
-                d->updateInProgress = true;
-                QFuture<QString> future =
-                    QtConcurrent::run
-                    (
-                        d,
-                        &HtmlPreviewPrivate::exportToHtml,
-                        d->document->toPlainText(),
-                        d->exporter
-                    );
-                d->futureWatcher->setFuture(future);
-            }
+    // Some markdown processors don't handle empty text very well
+    // and will err.  Thus, only pass in text from the document
+    // into the markdown processor if the text isn't empty or null.
+    //
+    if (d->document->isEmpty()) {
+        d->setHtmlContent(QVector<HtmlBlock>());
+    } else if (nullptr != d->exporter) {
+        QString text = d->document->toPlainText();
+
+        if (!text.isNull() && !text.isEmpty()) {
+            QFutureWatcher<QVector<HtmlBlock>> *watcher =
+                new QFutureWatcher<QVector<HtmlBlock>>(this);
+
+            this->connect
+            (
+                watcher,
+                &QFutureWatcher<QVector<HtmlBlock>>::finished,
+                [d, watcher, revision]() {
+                    d->onHtmlReady(revision, watcher->result());
+                    watcher->deleteLater();
+                }
+            );
+
+            watcher->setFuture
+            (
+                QtConcurrent::run
+                (
+                    &d->previewPool,
+                    &HtmlPreviewPrivate::exportToHtml,
+                    text,
+                    d->exporter,
+                    revision,
+                    &d->revision
+                )
+            );
         }
     }
 }
@@ -233,12 +270,22 @@ void HtmlPreview::navigateToHeading(int headingSequenceNumber)
     );
 }
 
+void HtmlPreview::navigateToLine(int line)
+{
+    this->page()->runJavaScript(QString("scrollToLine(%1);").arg(line));
+}
+
+void HtmlPreview::revealLine(int line)
+{
+    this->page()->runJavaScript(QString("revealLine(%1);").arg(line));
+}
+
 void HtmlPreview::setHtmlExporter(Exporter *exporter)
 {
     Q_D(HtmlPreview);
     
     d->exporter = exporter;
-    d->setHtmlContent("");
+    d->setHtmlContent(QVector<HtmlBlock>());
     updatePreview();
 }
 
@@ -249,18 +296,12 @@ void HtmlPreview::setStyleSheet(const QString &css)
     d->styleSheet.setText(css);
 }
 
-void HtmlPreviewPrivate::onHtmlReady()
+void HtmlPreviewPrivate::onHtmlReady(int revision, const QVector<HtmlBlock> &blocks)
 {
-    Q_Q(HtmlPreview);
-    
-    setHtmlContent(futureWatcher->result());
-    updateInProgress = false;
-
-    if (updateAgain) {
-        updateAgain = false;
-        q->updatePreview();
+    // Discard the results of a superseded revision.
+    if (revision == this->revision.loadAcquire()) {
+        setHtmlContent(blocks);
     }
-
 }
 
 void HtmlPreviewPrivate::onLoadFinished(bool ok)
@@ -276,14 +317,24 @@ void HtmlPreviewPrivate::updateBaseDir()
 {
     Q_Q(HtmlPreview);
     
+    QString dirPath;
+
     if (!document->filePath().isNull() && !document->filePath().isEmpty()) {
+        dirPath = QFileInfo(document->filePath()).dir().absolutePath();
+    }
+
+    if (PreviewSchemeHandler::isAvailable()) {
+        // Untitled documents are given the root directory, since the page
+        // still needs the scheme's origin to fetch blocks.
+        //
+        baseUrl = PreviewSchemeHandler::baseUrl(dirPath).toString();
+        schemeHandler.setDocumentDirectory(dirPath);
+    } else if (!dirPath.isEmpty()) {
         // Note that a forward slash ("/") is appended to the path to
         // ensure it works.  If the slash isn't there, then it won't
         // recognize the base URL for some reason.
         //
-        baseUrl =
-            QUrl::fromLocalFile(QFileInfo(document->filePath()).dir().absolutePath()
-                                + "/").toString();
+        baseUrl = QUrl::fromLocalFile(dirPath + "/").toString();
     } else {
         this->baseUrl = "";
     }
@@ -292,39 +343,69 @@ void HtmlPreviewPrivate::updateBaseDir()
     q->updatePreview();
 }
 
+void HtmlPreview::resizeEvent(QResizeEvent *event)
+{
+    Q_D(HtmlPreview);
+
+    QWebEngineView::resizeEvent(event);
+
+    // Images are shown no wider than the preview.
+    d->schemeHandler.setMaximumImageWidth(qRound(event->size().width() * this->devicePixelRatioF()));
+}
+
 void HtmlPreview::closeEvent(QCloseEvent *event)
 {
     Q_UNUSED(event);
     Q_D(HtmlPreview);
     
-    d->setHtmlContent("");
+    d->setHtmlContent(QVector<HtmlBlock>());
 }
 
-void HtmlPreviewPrivate::setHtmlContent(const QString &html)
+void HtmlPreviewPrivate::setHtmlContent(const QVector<HtmlBlock> &blocks)
 {
-    this->livePreviewHtml.setText(html);
+    this->livePreviewBlocks.setBlocks(blocks);
 }
 
-QString HtmlPreviewPrivate::exportToHtml
+QVector<HtmlBlock> HtmlPreviewPrivate::exportToHtml
 (
     const QString &text,
-    Exporter *exporter
-) const
+    Exporter *exporter,
+    int revision,
+    const QAtomicInt *latestRevision
+)
 {
-    QString html;
+    QVector<HtmlBlock> blocks;
+
+    // Don't bother rendering a revision that was superseded while
+    // waiting its turn.
+    if (revision != latestRevision->loadAcquire()) {
+        return blocks;
+    }
 
     // Enable smart typography for preview, if available for the exporter.
     bool smartTypographyEnabled = exporter->smartTypographyEnabled();
     exporter->setSmartTypographyEnabled(true);
 
+    // Let exporters that run external processes give up as soon as a
+    // newer revision is requested.
+    //
+    Exporter::setCancellationCheck
+    (
+        [revision, latestRevision]() {
+            return revision != latestRevision->loadAcquire();
+        }
+    );
+
     // Export to HTML.
-    exporter->exportToHtml(text, html);
+    exporter->exportToHtmlBlocks(text, blocks);
+
+    Exporter::setCancellationCheck(Exporter::CancellationCheck());
 
     // Put smart typography setting back to the way it was before
     // so that the last setting used during document export is remembered.
     //
     exporter->setSmartTypographyEnabled(smartTypographyEnabled);
 
-    return html;
+    return blocks;
 }
 } // namespace ghostwriter
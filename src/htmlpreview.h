@@ -61,6 +61,13 @@ public:
      */
     void contextMenuEvent(QContextMenuEvent *event);
 
+signals:
+    /**
+     * Emitted when the user scrolls the preview, with the line number
+     * (starting from 1) of the Markdown source now at the top.
+     */
+    void lineNavigated(int line);
+
 public slots:
     /**
      * Call this method to re-render the HTML for the document.
@@ -76,6 +83,19 @@ public slots:
      */
     void navigateToHeading(int headingSequenceNumber);
 
+    /**
+     * Call this method to scroll the preview so that the HTML rendered
+     * from the given line (starting from 1) of the Markdown source is at
+     * the top.
+     */
+    void navigateToLine(int line);
+
+    /**
+     * Call this method to scroll the preview only if the HTML rendered
+     * from the given line of the Markdown source is out of view.
+     */
+    void revealLine(int line);
+
     /**
      * Call this method to set the HTML exporter used in
      * generating HTML from the Markdown document.
@@ -88,6 +108,7 @@ public slots:
     void setStyleSheet(const QString &css);
 
 protected:
+    void resizeEvent(QResizeEvent *event);
     void closeEvent(QCloseEvent *event);
 
 private:
@@ -271,12 +271,13 @@ MainWindow::MainWindow(const QString &filePath, QWidget *parent)
         editor->setSpellCheckEnabled(false);
     }
 
-    connect
+    this->connect
     (
         documentStats,
-        SIGNAL(wordCountChanged(int)),
-        this,
-        SLOT(updateWordCount(int))
+        &DocumentStatistics::statisticsChanged,
+        [this](const StatisticsSnapshot &snapshot) {
+            updateWordCount(snapshot.wordCount);
+        }
     );
 
     this->connect
@@ -284,7 +285,15 @@ MainWindow::MainWindow(const QString &filePath, QWidget *parent)
         documentManager,
         &DocumentManager::documentLoaded,
         [this]() {
-            this->sessionStats->startNewSession(this->documentStats->wordCount());
+            // The loaded document's words are still being counted in the
+            // background, so start the session once they are.
+            //
+            if (this->documentStats->isCountingWords()) {
+                this->sessionStats->startNewSessionOnWordCount();
+            } else {
+                this->sessionStats->startNewSession(this->documentStats->wordCount());
+            }
+
             refreshRecentFiles();
         }
     );
@@ -298,29 +307,18 @@ MainWindow::MainWindow(const QString &filePath, QWidget *parent)
         }
     );
 
-    // Note that the parent widget for this new window must be NULL, so that
-    // it will hide beneath other windows when it is deactivated.
-    //
-    htmlPreview = new HtmlPreview
-    (
-        documentManager->document(),
-        appSettings->currentHtmlExporter(),
-        this
-    );
-
-    connect(editor, SIGNAL(textChanged()), htmlPreview, SLOT(updatePreview()));
-    connect(outlineWidget, SIGNAL(headingNumberNavigated(int)), htmlPreview, SLOT(navigateToHeading(int)));
-    connect(appSettings, SIGNAL(currentHtmlExporterChanged(Exporter *)), htmlPreview, SLOT(setHtmlExporter(Exporter *)));
-
-    htmlPreview->setMinimumWidth(0);
-    htmlPreview->setObjectName("htmlpreview");
-    htmlPreview->setVisible(appSettings->htmlPreviewVisible());
-
     previewSplitter = new QSplitter(this);
     previewSplitter->addWidget(editorPane);
-    previewSplitter->addWidget(htmlPreview);
     previewSplitter->setCollapsible(0, true);
-    previewSplitter->setCollapsible(1, true);
+
+    // The HTML preview starts a web engine process, so only create it
+    // once it is first shown.
+    //
+    htmlPreview = nullptr;
+
+    if (appSettings->htmlPreviewVisible()) {
+        createHtmlPreview();
+    }
 
 
     this->findReplace = new FindReplace(this->editor, this);
@@ -476,7 +474,10 @@ void MainWindow::quitApplication()
 
         this->editor->document()->disconnect();
         this->editor->disconnect();
-        this->htmlPreview->disconnect();
+
+        if (nullptr != this->htmlPreview) {
+            this->htmlPreview->disconnect();
+        }
 
         qApp->quit();
     }
@@ -514,8 +515,16 @@ void MainWindow::toggleHtmlPreview(bool checked)
     htmlPreviewMenuAction->blockSignals(true);
 
     htmlPreviewMenuAction->setChecked(checked);
-    htmlPreview->setVisible(checked);
-    htmlPreview->updatePreview();
+
+    if (checked && (nullptr == htmlPreview)) {
+        createHtmlPreview();
+    }
+
+    if (nullptr != htmlPreview) {
+        htmlPreview->setVisible(checked);
+        htmlPreview->updatePreview();
+    }
+
     adjustEditorWidth(this->width());
 
     htmlPreviewMenuAction->blockSignals(false);
@@ -1337,20 +1346,12 @@ void MainWindow::buildSidebar()
     outlineWidget->setAlternatingRowColors(false);
 
     documentStats = new DocumentStatistics((MarkdownDocument *) editor->document(), this);
-    connect(documentStats, SIGNAL(wordCountChanged(int)), documentStatsWidget, SLOT(setWordCount(int)));
-    connect(documentStats, SIGNAL(characterCountChanged(int)), documentStatsWidget, SLOT(setCharacterCount(int)));
-    connect(documentStats, SIGNAL(sentenceCountChanged(int)), documentStatsWidget, SLOT(setSentenceCount(int)));
-    connect(documentStats, SIGNAL(paragraphCountChanged(int)), documentStatsWidget, SLOT(setParagraphCount(int)));
-    connect(documentStats, SIGNAL(pageCountChanged(int)), documentStatsWidget, SLOT(setPageCount(int)));
-    connect(documentStats, SIGNAL(complexWordsChanged(int)), documentStatsWidget, SLOT(setComplexWords(int)));
-    connect(documentStats, SIGNAL(readingTimeChanged(int)), documentStatsWidget, SLOT(setReadingTime(int)));
-    connect(documentStats, SIGNAL(lixReadingEaseChanged(int)), documentStatsWidget, SLOT(setLixReadingEase(int)));
-    connect(documentStats, SIGNAL(readabilityIndexChanged(int)), documentStatsWidget, SLOT(setReadabilityIndex(int)));
+    connect(documentStats, SIGNAL(statisticsChanged(const StatisticsSnapshot &)), documentStatsWidget, SLOT(setStatistics(const StatisticsSnapshot &)));
     connect(editor, SIGNAL(textSelected(QString, int, int)), documentStats, SLOT(onTextSelected(QString, int, int)));
     connect(editor, SIGNAL(textDeselected()), documentStats, SLOT(onTextDeselected()));
 
     sessionStats = new SessionStatistics(this);
-    connect(documentStats, SIGNAL(totalWordCountChanged(int)), sessionStats, SLOT(onDocumentWordCountChanged(int)));
+    connect(documentStats, SIGNAL(wordCountSettled(int)), sessionStats, SLOT(onDocumentWordCountChanged(int)));
     connect(sessionStats, SIGNAL(wordCountChanged(int)), sessionStatsWidget, SLOT(setWordCount(int)));
     connect(sessionStats, SIGNAL(pageCountChanged(int)), sessionStatsWidget, SLOT(setPageCount(int)));
     connect(sessionStats, SIGNAL(wordsPerMinuteChanged(int)), sessionStatsWidget, SLOT(setWordsPerMinute(int)));
@@ -1433,6 +1434,54 @@ void MainWindow::buildSidebar()
     sidebar->setVisible(appSettings->sidebarVisible());
 }
 
+void MainWindow::createHtmlPreview()
+{
+    htmlPreview = new HtmlPreview
+    (
+        documentManager->document(),
+        appSettings->currentHtmlExporter(),
+        this
+    );
+
+    connect(editor, SIGNAL(textChanged()), htmlPreview, SLOT(updatePreview()));
+    connect(outlineWidget, SIGNAL(headingNumberNavigated(int)), htmlPreview, SLOT(navigateToHeading(int)));
+    connect(htmlPreview, SIGNAL(lineNavigated(int)), editor, SLOT(scrollToLine(int)));
+
+    // Keep the preview scrolled along with the editor.  The preview ignores
+    // a line it is already showing, so scrolling the editor from the
+    // preview doesn't bounce back.
+    //
+    this->connect
+    (
+        editor->verticalScrollBar(),
+        &QScrollBar::valueChanged,
+        [this]() {
+            if (htmlPreview->isVisible()) {
+                htmlPreview->navigateToLine(editor->cursorForPosition(QPoint(0, 0)).blockNumber() + 1);
+            }
+        }
+    );
+
+    this->connect
+    (
+        editor,
+        &MarkdownEditor::cursorPositionChanged,
+        [this]() {
+            if (htmlPreview->isVisible()) {
+                htmlPreview->revealLine(editor->textCursor().blockNumber() + 1);
+            }
+        }
+    );
+    connect(appSettings, SIGNAL(currentHtmlExporterChanged(Exporter *)), htmlPreview, SLOT(setHtmlExporter(Exporter *)));
+
+    htmlPreview->setMinimumWidth(0);
+    htmlPreview->setObjectName("htmlpreview");
+    htmlPreview->setStyleSheet(htmlPreviewCss);
+
+    previewSplitter->addWidget(htmlPreview);
+    previewSplitter->setCollapsible(1, true);
+}
+
 void MainWindow::adjustEditorWidth(int width)
 {
     QList<int> sidebarSplitterSizes;
@@ -1452,7 +1501,7 @@ void MainWindow::adjustEditorWidth(int width)
 
     sidebarSplitterSizes.append(editorWidth);
 
-    if (htmlPreview->isVisible()) {
+    if ((nullptr != htmlPreview) && htmlPreview->isVisible()) {
         editorWidth /= 2;
         previewSplitterSizes.append(editorWidth);
     }
@@ -1523,7 +1572,11 @@ void MainWindow::applyTheme()
     sessionStatsWidget->setStyleSheet("");
     sessionStatsWidget->setStyleSheet(styler.sidebarWidgetStyleSheet());
 
-    htmlPreview->setStyleSheet(styler.htmlPreviewCss());
+    htmlPreviewCss = styler.htmlPreviewCss();
+
+    if (nullptr != htmlPreview) {
+        htmlPreview->setStyleSheet(htmlPreviewCss);
+    }
 
     adjustEditorWidth(this->width());
 }
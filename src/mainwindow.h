@@ -120,6 +120,7 @@ private:
     QPushButton *focusModeButton;
     QPushButton *htmlPreviewButton;
     HtmlPreview *htmlPreview;
+    QString htmlPreviewCss;
     QAction *htmlPreviewMenuAction;
     QAction *fullScreenMenuAction;
     QPushButton *fullScreenButton;
@@ -156,6 +157,7 @@ private:
     void buildMenuBar();
     void buildStatusBar();
     void buildSidebar();
+    void createHtmlPreview();
 
     void adjustEditorWidth(int width);
 };
@@ -30,7 +30,7 @@ namespace ghostwriter
 class MarkdownASTPrivate
 {
 public:
-    MarkdownASTPrivate()
+    MarkdownASTPrivate() : signaturesValid(false)
     {
         ;
     }
@@ -42,6 +42,16 @@ public:
 
     MemoryArena<MarkdownNode> arena;
     MarkdownNode *root;
+    mutable QVector<uint> signatures;
+    mutable bool signaturesValid;
+
+    static uint nodeSignature
+    (
+        const MarkdownNode *node,
+        int depth,
+        bool firstLine,
+        bool lastLine
+    );
 };
 
 MarkdownAST::MarkdownAST()
@@ -78,6 +88,8 @@ void MarkdownAST::setRoot(cmark_node *root)
     Q_D(MarkdownAST);
     
     d->arena.freeAll();
+    d->signatures.clear();
+    d->signaturesValid = false;
 
     if (nullptr == root) {
         d->root = nullptr;
@@ -195,12 +207,161 @@ QVector<MarkdownNode *> MarkdownAST::headings() const
     return headings;
 }
 
+QVector<uint> MarkdownAST::lineSignatures() const
+{
+    Q_D(const MarkdownAST);
+
+    if (d->signaturesValid) {
+        return d->signatures;
+    }
+
+    d->signatures.clear();
+    d->signaturesValid = true;
+
+    if ((nullptr == d->root) || (MarkdownNode::Invalid == d->root->type())) {
+        return d->signatures;
+    }
+
+    // Do a pre-order traversal of the nodes, folding the signature of each
+    // node into the signatures of the lines it spans.  Note that inline
+    // nodes only affect the lines on which they start and end, which
+    // matches how the highlighter decides whether to format them.
+    QStack<const MarkdownNode *> nodes;
+    QStack<int> depths;
+
+    MarkdownNode *child = d->root->lastChild();
+
+    while (nullptr != child) {
+        nodes.push(child);
+        depths.push(0);
+        child = child->previous();
+    }
+
+    while (!nodes.isEmpty()) {
+        const MarkdownNode *node = nodes.pop();
+        int depth = depths.pop();
+
+        if (node->isInvalid()) {
+            continue;
+        }
+
+        int firstLine = node->startLine() - 1;
+        int lastLine = node->endLine() - 1;
+
+        if (firstLine < 0) {
+            firstLine = 0;
+        }
+
+        if (lastLine < firstLine) {
+            lastLine = firstLine;
+        }
+
+        if (lastLine >= d->signatures.size()) {
+            d->signatures.resize(lastLine + 1);
+        }
+
+        for (int line = firstLine; line <= lastLine; line++) {
+            if
+            (
+                node->isInlineType()
+                && (line != firstLine)
+                && (line != lastLine)
+            ) {
+                continue;
+            }
+
+            uint &signature = d->signatures[line];
+
+            signature = (31 * signature) +
+                MarkdownASTPrivate::nodeSignature
+                (
+                    node,
+                    depth,
+                    (line == firstLine),
+                    (line == lastLine)
+                );
+        }
+
+        child = node->lastChild();
+
+        while (nullptr != child) {
+            nodes.push(child);
+            depths.push(depth + 1);
+            child = child->previous();
+        }
+    }
+
+    return d->signatures;
+}
+
+QVector<int> MarkdownAST::changedLines
+(
+    const MarkdownAST *oldAst,
+    const MarkdownAST *newAst
+)
+{
+    QVector<int> lines;
+
+    if (nullptr == newAst) {
+        return lines;
+    }
+
+    QVector<uint> newSignatures = newAst->lineSignatures();
+    QVector<uint> oldSignatures;
+
+    if (nullptr != oldAst) {
+        oldSignatures = oldAst->lineSignatures();
+    }
+
+    // Skip past the lines at the beginning and at the end that have
+    // the same structure in both trees.
+    int prefix = 0;
+    int maxPrefix = qMin(oldSignatures.size(), newSignatures.size());
+
+    while
+    (
+        (prefix < maxPrefix)
+        && (oldSignatures[prefix] == newSignatures[prefix])
+    ) {
+        prefix++;
+    }
+
+    int oldEnd = oldSignatures.size();
+    int newEnd = newSignatures.size();
+
+    while
+    (
+        (oldEnd > prefix)
+        && (newEnd > prefix)
+        && (oldSignatures[oldEnd - 1] == newSignatures[newEnd - 1])
+    ) {
+        oldEnd--;
+        newEnd--;
+    }
+
+    // If the remaining ranges line up, then only the lines whose
+    // signatures actually differ have changed.  Otherwise, lines were
+    // inserted or removed, and the entire range needs to be considered
+    // as changed.
+    bool sameLength = ((oldEnd - prefix) == (newEnd - prefix));
+
+    for (int line = prefix; line < newEnd; line++) {
+        if (!sameLength || (oldSignatures[line] != newSignatures[line])) {
+            lines.append(line);
+        }
+    }
+
+    return lines;
+}
+
 void MarkdownAST::clear()
 {
     Q_D(MarkdownAST);
     
     d->arena.freeAll();
     d->root = nullptr;
+    d->signatures.clear();
+    d->signaturesValid = false;
 }
 
 QString MarkdownAST::toString() const
@@ -242,4 +403,50 @@ QString MarkdownAST::toString() const
 
     return text;
 }
+uint MarkdownASTPrivate::nodeSignature
+(
+    const MarkdownNode *node,
+    int depth,
+    bool firstLine,
+    bool lastLine
+)
+{
+    uint signature = (uint) node->type();
+
+    signature = (31 * signature) + (uint) depth;
+    signature = (31 * signature) + (firstLine ? 1 : 0);
+    signature = (31 * signature) + (lastLine ? 1 : 0);
+
+    if (node->isInlineType()) {
+        // Inline extents only matter on the lines where they are located.
+        signature = (31 * signature) + (uint) node->position();
+        signature = (31 * signature) + (uint) node->length();
+        return signature;
+    }
+
+    switch (node->type()) {
+    case MarkdownNode::Heading:
+        signature = (31 * signature) + (uint) node->headingLevel();
+        signature = (31 * signature) + (node->isSetextHeading() ? 1 : 0);
+        break;
+    case MarkdownNode::CodeBlock:
+        signature = (31 * signature) + (node->isFencedCodeBlock() ? 1 : 0);
+        break;
+    case MarkdownNode::ListItem:
+        signature = (31 * signature) + (node->isNumberedListItem() ? 1 : 0);
+        break;
+    default:
+        break;
+    }
+
+    if (firstLine) {
+        signature = (31 * signature) + (uint) node->position();
+    }
+
+    if (lastLine) {
+        signature = (31 * signature) + (uint) node->length();
+    }
+
+    return signature;
+}
 } // namespace ghostwriter
@@ -21,6 +21,7 @@
 #define MARKDOWN_AST_H
 
 #include <QScopedPointer>
+#include <QVector>
 
 #include "markdownnode.h"
 #include "memoryarena.h"
@@ -86,6 +87,28 @@ public:
      */
     QVector<MarkdownNode *> headings() const;
 
+    /**
+     * Returns a hash for each line of the original Markdown text, indexed
+     * from zero, that summarizes the structure of the nodes spanning that
+     * line:  their types, nesting depth, and inline extents.  The hashes
+     * do not depend on absolute line numbers, so that structure that is
+     * merely shifted up or down by an edit compares as unchanged.  The
+     * result is computed on first use and then cached.
+     */
+    QVector<uint> lineSignatures() const;
+
+    /**
+     * Compares the line signatures of the two given ASTs, and returns the
+     * zero-based line numbers within newAst whose node structure differs
+     * from that of the corresponding line in oldAst.  If oldAst is
+     * nullptr, all lines of newAst are returned.
+     */
+    static QVector<int> changedLines
+    (
+        const MarkdownAST *oldAst,
+        const MarkdownAST *newAst
+    );
+
     /**
      * Frees memory for this AST.
      */
@@ -23,23 +23,34 @@
 #include <QFileInfo>
 
 #include "markdowndocument.h"
+#include "textblockdata.h"
 
 namespace ghostwriter
 {
 MarkdownDocument::MarkdownDocument(QObject *parent)
-    : QTextDocument(parent), ast(nullptr)
+    : QTextDocument(parent), ast(nullptr), textBlocksRemovedPending(false)
 {
     initializeUntitledDocument();
 }
 
 MarkdownDocument::MarkdownDocument(const QString &text, QObject *parent)
-    : QTextDocument(text, parent), ast(nullptr)
+    : QTextDocument(text, parent), ast(nullptr), textBlocksRemovedPending(false)
 {
     initializeUntitledDocument();
 }
 
 MarkdownDocument::~MarkdownDocument()
 {
+    // The blocks are destroyed by the QTextDocument destructor, after this
+    // object is gone, so their data must not call back into it.
+    for (QTextBlock block = this->begin(); block.isValid(); block = block.next()) {
+        TextBlockData *blockData = (TextBlockData *) block.userData();
+
+        if (nullptr != blockData) {
+            blockData->document = nullptr;
+        }
+    }
+
     QPlainTextDocumentLayout *documentLayout =
         new QPlainTextDocumentLayout(this);
     this->setDocumentLayout(documentLayout);
@@ -114,13 +125,41 @@ MarkdownAST *MarkdownDocument::markdownAST() const
 
 void MarkdownDocument::setMarkdownAST(MarkdownAST *ast)
 {
+    MarkdownAST *oldAst = this->ast;
+    QVector<int> changedLines = MarkdownAST::changedLines(oldAst, ast);
+
     this->ast = ast;
+
+    if ((nullptr != oldAst) && (oldAst != ast)) {
+        delete oldAst;
+    }
+
+    if (!changedLines.isEmpty()) {
+        emit markdownStructureChanged(changedLines);
+    }
+}
+
+void MarkdownDocument::notifyTextBlockRemoved(const TextBlockData *blockData)
+{
+    emit textBlockRemoved(blockData);
+
+    // Deleting many lines at once removes one block at a time.  Notify
+    // listeners only once all of them are gone.
+    if (!textBlocksRemovedPending) {
+        textBlocksRemovedPending = true;
+        QMetaObject::invokeMethod(this, "emitTextBlocksRemoved", Qt::QueuedConnection);
+    }
+}
+
+void MarkdownDocument::emitTextBlocksRemoved()
+{
+    textBlocksRemovedPending = false;
+    emit textBlocksRemoved();
 }
 
-void MarkdownDocument::notifyTextBlockRemoved(const QTextBlock &block)
+void MarkdownDocument::notifyTextBlockProseChanged(const QTextBlock &block)
 {
-    emit textBlockRemoved(block.position());
-    emit textBlockRemoved(block);
+    emit textBlockProseChanged(block);
 }
 
 void MarkdownDocument::initializeUntitledDocument()
@@ -24,10 +24,13 @@
 #include <QString>
 #include <QDateTime>
 #include <QTextBlock>
+#include <QVector>
 #include "markdownast.h"
 
 namespace ghostwriter
 {
+class TextBlockData;
+
 /**
  * Text document that maintains timestamp, read-only state, and new vs.
  * saved status.
@@ -96,14 +99,27 @@ public:
     void setTimestamp(const QDateTime &timestamp);
 
     MarkdownAST *markdownAST() const;
+
+    /**
+     * Sets the Markdown AST for this document, freeing the memory of the
+     * prior AST.  Emits markdownStructureChanged() with the lines whose
+     * node structure differs from that of the prior AST.
+     */
     void setMarkdownAST(MarkdownAST *ast);
 
     /**
-     * For internal use only with TextBlockData class.  Emits signals
-     * to notify listeners that the given text block is about to be
+     * For internal use only with TextBlockData class.  Emits
+     * textBlockRemoved() for the given block data and schedules
+     * textBlocksRemoved() to notify listeners that text blocks were
      * removed from the document.
      */
-    void notifyTextBlockRemoved(const QTextBlock &block);
+    void notifyTextBlockRemoved(const TextBlockData *blockData);
+
+    /**
+     * For internal use only with MarkdownHighlighter class.  Emits
+     * textBlockProseChanged() for the given text block.
+     */
+    void notifyTextBlockProseChanged(const QTextBlock &block);
 
 signals:
     /**
@@ -112,16 +128,34 @@ signals:
     void filePathChanged();
 
     /**
-     * Emitted when the QTextBlock at the given position in the document
-     * is removed.
+     * Emitted while a QTextBlock is being removed from the document,
+     * with the user data it carried.  Listeners must only read the
+     * given data and must not access the document, which is in the
+     * middle of an edit.
+     */
+    void textBlockRemoved(const TextBlockData *blockData);
+
+    /**
+     * Emitted once from the event loop after one or more QTextBlocks
+     * were removed from the document, for example by deleting a
+     * selection that spans several lines.
+     */
+    void textBlocksRemoved();
+
+    /**
+     * Emitted when the prose text of a QTextBlock changes, that is, the
+     * block's text with code, HTML, URLs and other markup skipped over.
+     * Parameter is the changed QTextBlock.
      */
-    void textBlockRemoved(int position);
+    void textBlockProseChanged(const QTextBlock &block);
 
     /**
-     * Emitted when a QTextBlock is removed from the document.  Parameter
-     * is the QTextBlock that is being removed.
+     * Emitted when a newly set Markdown AST changes the structure of
+     * lines in the document (for example, when a code fence is opened,
+     * changing the meaning of all following lines).  Parameter is the
+     * list of affected block numbers.
      */
-    void textBlockRemoved(const QTextBlock &block);
+    void markdownStructureChanged(const QVector<int> &blockNumbers);
 
 private:
     QString m_displayName;
@@ -129,11 +163,19 @@ private:
     bool readOnlyFlag;
     QDateTime m_timestamp;
     MarkdownAST *ast;
+    bool textBlocksRemovedPending;
 
     /*
     * Initializes the class for an untitled document.
     */
     void initializeUntitledDocument();
+
+private slots:
+    /*
+    * Emits textBlocksRemoved() for the blocks removed since it was last
+    * emitted.
+    */
+    void emitTextBlocksRemoved();
 };
 } // namespace ghostwriter
 
@@ -25,6 +25,7 @@
 #include <QDesktopWidget>
 #include <QDir>
 #include <QFileInfo>
+#include <QFutureWatcher>
 #include <QGuiApplication>
 #include <QHeaderView>
 #include <QMenu>
@@ -35,10 +36,10 @@
 #include <QScreen>
 #include <QScrollBar>
 #include <QString>
-#include <QTextBoundaryFinder>
 #include <QTextStream>
 #include <QTimer>
 #include <QUrl>
+#include <QtConcurrentRun>
 
 #include <QGridLayout>
 #include <QLayout>
@@ -54,12 +55,18 @@
 #include "markdowneditor.h"
 #include "markdownhighlighter.h"
 #include "markdownstates.h"
+#include "sentencesegmenter.h"
+#include "textblockdata.h"
 #include "spelling/dictionary_manager.h"
 #include "spelling/dictionary_ref.h"
 #include "spelling/spell_checker.h"
 
 #define GW_TEXT_FADE_FACTOR 1.5
 
+// Time in milliseconds to wait for spelling suggestions after the context
+// menu is shown.
+#define GW_SUGGESTIONS_DEADLINE_MS 2000
+
 namespace ghostwriter
 {
 class MarkdownEditorPrivate
@@ -149,6 +156,19 @@ public:
     void toggleCursorBlink();
     void parseDocument();
 
+    void insertSuggestions
+    (
+        QMenu *menu,
+        QAction *before,
+        const QStringList &suggestions
+    );
+    void finishSuggestions(QMenu *menu, QAction *placeholder);
+    static QStringList findSuggestions
+    (
+        const DictionaryRef &dictionary,
+        const QString &word
+    );
+
     void handleCarriageReturn();
     bool handleBackspaceKey();
     void insertPrefixForBlocks(const QString &prefix);
@@ -255,7 +275,7 @@ MarkdownEditor::MarkdownEditor
 
     connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(onCursorPositionChanged()));
     connect(this->document(), SIGNAL(contentsChange(int, int, int)), this, SLOT(onContentsChanged(int, int, int)));
-    connect(this->document(), SIGNAL(textBlockRemoved(const QTextBlock &)), this, SLOT(onTextBlockRemoved(const QTextBlock &)));
+    connect(this->document(), SIGNAL(textBlocksRemoved()), this, SLOT(onTextBlocksRemoved()));
     connect(this, SIGNAL(selectionChanged()), this, SLOT(onSelectionChanged()));
 
     d->highlighter = new MarkdownHighlighter(this, colors);
@@ -865,31 +885,88 @@ bool MarkdownEditor::eventFilter(QObject *watched, QEvent *event)
         );
 
         d->wordUnderMouse = d->cursorForWord.selectedText();
-        QStringList suggestions = d->dictionary.suggestions(d->wordUnderMouse);
+
+        // Use the dictionary the block was spell checked with, in case its
+        // language was detected to be other than the default.
+        //
+        DictionaryRef dictionary = d->dictionary;
+        TextBlockData *blockData =
+            (TextBlockData *) d->cursorForWord.block().userData();
+
+        if ((nullptr != blockData) && !blockData->language.isEmpty()) {
+            dictionary =
+                DictionaryManager::instance().requestDictionary(blockData->language);
+        }
+
+        // Look up suggestions from the dictionary in the background, since
+        // this can take a long time for some words.
+        //
+        QFuture<QStringList> suggestions =
+            QtConcurrent::run
+            (
+                &MarkdownEditorPrivate::findSuggestions,
+                DictionaryManager::instance().pin(dictionary),
+                d->wordUnderMouse
+            );
+
         QMenu *popupMenu = createStandardContextMenu();
         QAction *firstAction = popupMenu->actions().first();
 
         d->spellingActions.clear();
 
-        if (!suggestions.empty()) {
-            for (int i = 0; i < suggestions.size(); i++) {
-                QAction *suggestionAction = new QAction(suggestions[i], this);
+        // Close matches from the personal dictionary come from an index,
+        // and are always available right away.
+        //
+        d->insertSuggestions
+        (
+            popupMenu,
+            firstAction,
+            DictionaryManager::instance().personalSuggestions(d->wordUnderMouse)
+        );
 
-                // Need the following line because KDE Plasma 5 will insert a hidden ampersand
-                // into the menu text as a keyboard accelerator.  Go off of the data in the
-                // QAction rather than the text to avoid this.
-                //
-                suggestionAction->setData(suggestions[i]);
+        QAction *placeholderAction =
+            new QAction(tr("Searching for spelling suggestions..."), this);
+        placeholderAction->setEnabled(false);
+        d->spellingActions.append(placeholderAction);
+        popupMenu->insertAction(firstAction, placeholderAction);
 
-                d->spellingActions.append(suggestionAction);
-                popupMenu->insertAction(firstAction, suggestionAction);
-            }
+        if (suggestions.isFinished()) {
+            d->insertSuggestions(popupMenu, placeholderAction, suggestions.result());
+            d->finishSuggestions(popupMenu, placeholderAction);
         } else {
-            QAction *noSuggestionsAction =
-                new QAction(tr("No spelling suggestions found"), this);
-            noSuggestionsAction->setEnabled(false);
-            d->spellingActions.append(noSuggestionsAction);
-            popupMenu->insertAction(firstAction, noSuggestionsAction);
+            // Add the suggestions to the menu when they arrive, unless the
+            // deadline passes first.  If the menu closes before then, the
+            // watcher is deleted with it, but the lookup still runs to
+            // completion so that its result is remembered by the dictionary.
+            //
+            QFutureWatcher<QStringList> *watcher =
+                new QFutureWatcher<QStringList>(popupMenu);
+            QTimer *deadline = new QTimer(popupMenu);
+            deadline->setSingleShot(true);
+
+            connect
+            (
+                watcher,
+                &QFutureWatcher<QStringList>::finished,
+                [d, popupMenu, placeholderAction, watcher, deadline]() {
+                    if (deadline->isActive()) {
+                        deadline->stop();
+                        d->insertSuggestions(popupMenu, placeholderAction, watcher->result());
+                        d->finishSuggestions(popupMenu, placeholderAction);
+                    }
+                }
+            );
+            connect
+            (
+                deadline,
+                &QTimer::timeout,
+                [d, popupMenu, placeholderAction]() {
+                    d->finishSuggestions(popupMenu, placeholderAction);
+                }
+            );
+
+            deadline->start(GW_SUGGESTIONS_DEADLINE_MS);
+            watcher->setFuture(suggestions);
         }
 
         popupMenu->insertSeparator(firstAction);
@@ -975,6 +1052,19 @@ void MarkdownEditor::navigateDocument(const int position)
     this->setFocus();
 }
 
+void MarkdownEditor::scrollToLine(int line)
+{
+    // Lines past the end, such as that of the preview's footnotes, go to
+    // the last block.
+    QTextBlock block =
+        this->document()->findBlockByNumber(qMin(line, this->document()->blockCount()) - 1);
+
+    if (block.isValid()) {
+        // The scroll bar counts wrapped lines, not blocks.
+        this->verticalScrollBar()->setValue(block.firstLineNumber());
+    }
+}
+
 void MarkdownEditor::bold()
 {
     Q_D(MarkdownEditor);
@@ -1494,7 +1584,6 @@ void MarkdownEditor::suggestSpelling(QAction *action)
     if (action == d->addWordToDictionaryAction) {
         this->setTextCursor(d->cursorForWord);
         d->dictionary.addToPersonal(d->wordUnderMouse);
-        d->highlighter->rehighlight();
     } else if (action == d->checkSpellingAction) {
         this->setTextCursor(d->cursorForWord);
         SpellChecker::checkDocument(this, d->highlighter, d->dictionary);
@@ -1529,7 +1618,7 @@ void MarkdownEditor::onContentsChanged(int position, int charsAdded, int charsRe
     }
 }
 
-void MarkdownEditor::onTextBlockRemoved(const QTextBlock &)
+void MarkdownEditor::onTextBlocksRemoved()
 {
     Q_D(MarkdownEditor);
     
@@ -1610,15 +1699,20 @@ void MarkdownEditor::focusText()
             break;
 
         case FocusModeSentence: { // Current sentence
-            QTextBoundaryFinder boundaryFinder(QTextBoundaryFinder::Sentence, this->textCursor().block().text());
+            QVector<int> boundaries =
+                SentenceSegmenter::boundaries(this->textCursor().block());
             int currentPos = this->textCursor().positionInBlock();
-            int lastSentencePos = 0;
-            int nextSentencePos = 0;
-
-            boundaryFinder.setPosition(currentPos);
-            lastSentencePos = boundaryFinder.toPreviousBoundary();
-            boundaryFinder.setPosition(currentPos);
-            nextSentencePos = boundaryFinder.toNextBoundary();
+            int lastSentencePos = -1;
+            int nextSentencePos = -1;
+
+            foreach (int boundary, boundaries) {
+                if (boundary < currentPos) {
+                    lastSentencePos = boundary;
+                } else if (boundary > currentPos) {
+                    nextSentencePos = boundary;
+                    break;
+                }
+            }
 
             if (lastSentencePos < 0) {
                 beforeFadedSelection.cursor.movePosition(QTextCursor::StartOfBlock);
@@ -1753,6 +1847,63 @@ void MarkdownEditorPrivate::parseDocument()
     ((MarkdownDocument *) q->document())->setMarkdownAST(ast);
 }
 
+void MarkdownEditorPrivate::insertSuggestions
+(
+    QMenu *menu,
+    QAction *before,
+    const QStringList &suggestions
+)
+{
+    Q_Q(MarkdownEditor);
+
+    foreach (const QString &suggestion, suggestions) {
+        bool duplicate = false;
+
+        foreach (QAction *action, spellingActions) {
+            if (action->data().toString() == suggestion) {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (duplicate) {
+            continue;
+        }
+
+        QAction *suggestionAction = new QAction(suggestion, q);
+
+        // Need the following line because KDE Plasma 5 will insert a hidden ampersand
+        // into the menu text as a keyboard accelerator.  Go off of the data in the
+        // QAction rather than the text to avoid this.
+        //
+        suggestionAction->setData(suggestion);
+
+        spellingActions.append(suggestionAction);
+        menu->insertAction(before, suggestionAction);
+    }
+}
+
+void MarkdownEditorPrivate::finishSuggestions(QMenu *menu, QAction *placeholder)
+{
+    // The placeholder is the only spelling action if no suggestions were
+    // found, in which case it is kept in the menu to say so.
+    //
+    if (spellingActions.size() > 1) {
+        menu->removeAction(placeholder);
+    } else {
+        placeholder->setText(MarkdownEditor::tr("No spelling suggestions found"));
+    }
+}
+
+QStringList MarkdownEditorPrivate::findSuggestions
+(
+    const DictionaryRef &dictionary,
+    const QString &word
+)
+{
+    return dictionary.suggestions(word);
+}
+
 void MarkdownEditorPrivate::handleCarriageReturn()
 {
     Q_Q(MarkdownEditor);
@@ -205,6 +205,12 @@ public slots:
      */
     void navigateDocument(const int position);
 
+    /**
+     * Scrolls the editor so that the given line (starting from 1) is at
+     * the top, without moving the cursor.
+     */
+    void scrollToLine(int line);
+
     /**
      * Inserts bold formatting.
      */
@@ -365,7 +371,7 @@ public slots:
 protected slots:
     void suggestSpelling(QAction *action);
     void onContentsChanged(int position, int charsAdded, int charsRemoved);
-    void onTextBlockRemoved(const QTextBlock &);
+    void onTextBlocksRemoved();
     void onSelectionChanged();
     void focusText();
     void checkIfTypingPaused();
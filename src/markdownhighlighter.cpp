@@ -26,6 +26,7 @@
 #include <QRegularExpression>
 #include <QStaticText>
 #include <QString>
+#include <QStringList>
 #include <QSyntaxHighlighter>
 #include <QTextCharFormat>
 #include <QTextDocument>
@@ -36,14 +37,69 @@
 #include <Qt>
 #include <QTextLayout>
 #include <QStack>
+#include <QMap>
+#include <QSet>
+#include <QFutureWatcher>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 
 #include "markdownhighlighter.h"
 #include "markdownstates.h"
+#include "textblockdata.h"
 #include "spelling/dictionary_ref.h"
 #include "spelling/dictionary_manager.h"
+#include "spelling/language_detector.h"
+
+// Number of characters of the surrounding paragraph to use for detecting
+// the language of a text block.
+#define GW_PARAGRAPH_SAMPLE_LENGTH 2000
 
 namespace ghostwriter
 {
+/*
+ * Results of a background spell check of a text block.
+ */
+struct SpellCheckResult
+{
+    // Language detected for the block, or empty if the default
+    // dictionary was used.
+    QString language;
+    QVector<TextBlockData::Misspelling> misspellings;
+};
+
+/*
+ * Text block queued for a background spell check, along with its prose
+ * text and the hash and dictionary generation it is checked for.
+ */
+struct SpellCheckRequest
+{
+    QTextBlock block;
+    uint key;
+    int generation;
+    QString text;
+};
+
+/*
+ * Prose texts to spell check in one background job, along with the
+ * paragraphs they are in (for language detection, if enabled) and the
+ * dictionaries to check them with.
+ */
+struct SpellCheckJob
+{
+    SpellCheckJob(const DictionaryRef &dictionary)
+        : dictionary(dictionary), detector(nullptr)
+    {
+        ;
+    }
+
+    DictionaryRef dictionary;
+    const LanguageDetector *detector;
+    QString defaultLanguage;
+    QHash<QString, DictionaryRef> dictionaries;
+    QStringList paragraphs;
+    QStringList texts;
+};
+
 class MarkdownHighlighterPrivate
 {
     Q_DISABLE_COPY(MarkdownHighlighterPrivate)
@@ -56,9 +112,15 @@ public:
         inBlockquote(false),
         spellCheckEnabled(false),
         typingPaused(true),
-        useUndlerlineForEmphasis(false)
+        useUndlerlineForEmphasis(false),
+        proseRangesValid(false),
+        spellCheckGeneration(0),
+        spellCheckScheduled(false),
+        checkedWithPendingDictionary(false)
     {
-        ;
+        // Dictionaries are not safe for concurrent use, so run one spell
+        // check at a time, in the order that they were requested.
+        spellCheckPool.setMaxThreadCount(1);
     }
 
     ~MarkdownHighlighterPrivate()
@@ -83,14 +145,50 @@ public:
     bool useLargeHeadings;
     bool useUndlerlineForEmphasis;
     bool italicizeBlockquotes;
+    QMap<int, QTextBlock> pendingBlocks;
+    QVector<TextBlockData::TextRange> proseRanges;
+    bool proseRangesValid;
+    QThreadPool spellCheckPool;
+    int spellCheckGeneration;
+    QVector<SpellCheckRequest> spellCheckRequests;
+    bool spellCheckScheduled;
+    bool checkedWithPendingDictionary;
 
     bool isSetextHeadingState(const int state);
     bool lineMatchesNode(const int line, const MarkdownNode *const node) const;
     int columnInLine(const MarkdownNode *const node, const QString &lineText) const;
     void applyFormattingForNode(const MarkdownNode *const node);
     void highlightRefLinks(const int pos, const int length);
+    void addProseRange(const int pos, const int length);
+    TextBlockData *currentBlockData();
     void setupHeadingFontSize(bool useLargeHeadings);
-    void spellCheck(const QString &text);
+    void spellCheck(const QString &text, const QString &prose, uint key);
+    void requestSpellCheck
+    (
+        const QTextBlock &block,
+        TextBlockData *blockData,
+        const QString &text,
+        uint key
+    );
+    void onSpellCheckFinished
+    (
+        const QTextBlock &block,
+        uint key,
+        int generation,
+        int textLength,
+        const SpellCheckResult &result
+    );
+
+    void startSpellCheck();
+
+    static QString paragraphText(const QTextBlock &block, const QString &prose);
+    static QVector<SpellCheckResult> runSpellCheck(const SpellCheckJob &job);
+    static SpellCheckResult findMisspellings
+    (
+        const SpellCheckJob &job,
+        const QString &paragraph,
+        const QString &text
+    );
 };
 
 MarkdownHighlighter::MarkdownHighlighter
@@ -111,12 +209,33 @@ MarkdownHighlighter::MarkdownHighlighter
     d->inBlockquote = false;
 
     setDocument(editor->document());
+
+    // Note:  This connection must be made after setDocument() so that it is
+    // handled after QSyntaxHighlighter has highlighted the edited blocks.
+    connect
+    (
+        editor->document(),
+        SIGNAL(contentsChange(int, int, int)),
+        this,
+        SLOT(onContentsChange(int, int, int))
+    );
+
+    connect
+    (
+        editor->document(),
+        SIGNAL(markdownStructureChanged(const QVector<int> &)),
+        this,
+        SLOT(onMarkdownStructureChanged(const QVector<int> &))
+    );
+
     d->referenceDefinitionRegex.setPattern("^\\s*\\[(.+?)[^\\\\]\\]:");
     d->inlineHtmlCommentRegex.setPattern("^\\s*<\\!--.*-->\\s*$");
 
     connect(editor, SIGNAL(typingResumed()), this, SLOT(onTypingResumed()));
     connect(editor, SIGNAL(typingPausedScaled()), this, SLOT(onTypingPaused()));
     connect(editor, SIGNAL(cursorPositionChanged()), this, SLOT(onCursorPositionChanged()));
+    connect(&DictionaryManager::instance(), SIGNAL(changed()), this, SLOT(onDictionaryChanged()));
+    connect(&DictionaryManager::instance(), SIGNAL(loaded(QString)), this, SLOT(onDictionaryLoaded(QString)));
 
     connect
     (
@@ -139,7 +258,10 @@ MarkdownHighlighter::MarkdownHighlighter
 
 MarkdownHighlighter::~MarkdownHighlighter()
 {
-    ;
+    Q_D(MarkdownHighlighter);
+
+    d->spellCheckPool.clear();
+    d->spellCheckPool.waitForDone();
 }
 
 // Note:  Never set the QTextBlockFormat for a QTextBlock from within the
@@ -169,20 +291,31 @@ void MarkdownHighlighter::highlightBlock(const QString &text)
         node = ast->findBlockAtLine(line);
     }
 
+    // Prose ranges are collected from the text nodes while formatting.
+    // If there is no node, they can only be known for lines that have
+    // no prose at all.
+    d->proseRanges.clear();
+    d->proseRangesValid = false;
+
     if ((nullptr != node) && (MarkdownNode::Invalid != node->type())) {
+        d->proseRangesValid = true;
         d->applyFormattingForNode(node);
     } else {
         setFormat(0, currentBlock().length(), d->colors.foreground);
 
         if (currentBlock().text().trimmed().isEmpty()) {
+            d->proseRangesValid = true;
             setCurrentBlockState(MarkdownStateParagraphBreak);
         } else if (d->referenceDefinitionRegex.match(currentBlock().text()).hasMatch()) {
+            d->proseRangesValid = true;
             QTextCharFormat format = d->defaultFormat;
             format.setForeground(d->colors.link);
 
             setFormat(0, currentBlock().text().indexOf(':'), format);
             setCurrentBlockState(MarkdownStateParagraph);
         } else if (d->inlineHtmlCommentRegex.match(currentBlock().text()).hasMatch()) {
+            d->proseRangesValid = true;
+
             QTextCharFormat format = d->defaultFormat;
             format.setForeground(d->colors.inlineHtml);
             setFormat(0, currentBlock().text().length(), format);
@@ -247,8 +380,22 @@ void MarkdownHighlighter::highlightBlock(const QString &text)
         this->setFormat(currentBlock().text().length() - 2, 2, format);
     }
 
+    TextBlockData *blockData = d->currentBlockData();
+    blockData->proseRanges = d->proseRanges;
+    blockData->proseRangesValid = d->proseRangesValid;
+
+    QString prose = blockData->proseText(text);
+    uint key = qHash(prose);
+
+    // Let the document statistics recount the words in the block.
+    if (!blockData->proseKeyValid || (key != blockData->proseKey)) {
+        blockData->proseKey = key;
+        blockData->proseKeyValid = true;
+        ((MarkdownDocument *) document())->notifyTextBlockProseChanged(currentBlock());
+    }
+
     if (d->spellCheckEnabled) {
-        d->spellCheck(text);
+        d->spellCheck(text, prose, key);
     }
 }
 
@@ -257,6 +404,7 @@ void MarkdownHighlighter::setDictionary(const DictionaryRef &dictionary)
     Q_D(MarkdownHighlighter);
 
     d->dictionary = dictionary;
+    d->spellCheckGeneration++;
 
     if (d->spellCheckEnabled) {
         rehighlight();
@@ -374,23 +522,193 @@ void MarkdownHighlighter::onHighlightBlockAtPosition(int position)
     rehighlightBlock(block);
 }
 
-void MarkdownHighlighterPrivate::spellCheck(const QString &text)
+void MarkdownHighlighter::onDictionaryChanged()
+{
+    Q_D(MarkdownHighlighter);
+
+    // Words may have been added to or removed from the dictionary, so
+    // previous spell check results are no longer valid.
+    d->spellCheckGeneration++;
+
+    if (d->spellCheckEnabled) {
+        rehighlight();
+    }
+}
+
+void MarkdownHighlighter::onDictionaryLoaded(const QString &language)
+{
+    Q_D(MarkdownHighlighter);
+
+    if (!d->spellCheckEnabled) {
+        return;
+    }
+
+    // Blocks without a detected language were checked with the default
+    // dictionary, which only needs checking again if it was still loading.
+    bool recheckDefault =
+        d->checkedWithPendingDictionary
+        && !DictionaryManager::isPending(d->dictionary);
+
+    if (recheckDefault) {
+        d->checkedWithPendingDictionary = false;
+    }
+
+    for
+    (
+        QTextBlock block = document()->begin();
+        block.isValid();
+        block = block.next()
+    ) {
+        TextBlockData *blockData = (TextBlockData *) block.userData();
+
+        if
+        (
+            (nullptr == blockData)
+            || (blockData->spellCheckGeneration < 0)
+        ) {
+            continue;
+        }
+
+        bool recheck = blockData->language.isEmpty()
+            ? recheckDefault
+            : (language == blockData->language);
+
+        if (recheck) {
+            QString prose = blockData->proseText(block.text());
+
+            // Supersede any check already in progress, since it may be
+            // using the placeholder for the dictionary that just loaded.
+            blockData->pendingSpellCheckKey = 0;
+            blockData->pendingSpellCheckGeneration = -1;
+            d->requestSpellCheck(block, blockData, prose, qHash(prose));
+        }
+    }
+}
+
+void MarkdownHighlighter::onMarkdownStructureChanged(const QVector<int> &blockNumbers)
+{
+    Q_D(MarkdownHighlighter);
+
+    bool wasEmpty = d->pendingBlocks.isEmpty();
+
+    foreach (int blockNumber, blockNumbers) {
+        QTextBlock block = document()->findBlockByNumber(blockNumber);
+
+        if (block.isValid()) {
+            d->pendingBlocks.insert(blockNumber, block);
+        }
+    }
+
+    // Rehighlighting cannot be done recursively from within the document's
+    // change notifications, so queue it in the event system instead.  See
+    // explanation for highlightBlockAtPosition().
+    if (wasEmpty && !d->pendingBlocks.isEmpty()) {
+        QMetaObject::invokeMethod(this, "rehighlightPendingBlocks", Qt::QueuedConnection);
+    }
+}
+
+void MarkdownHighlighter::onContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    Q_D(MarkdownHighlighter);
+
+    Q_UNUSED(charsRemoved)
+
+    if (d->pendingBlocks.isEmpty()) {
+        return;
+    }
+
+    int first = document()->findBlock(position).blockNumber();
+    int last = document()->findBlock(position + charsAdded).blockNumber();
+
+    if (last < 0) {
+        last = document()->blockCount() - 1;
+    }
+
+    QMap<int, QTextBlock>::iterator iter = d->pendingBlocks.lowerBound(first);
+
+    while ((iter != d->pendingBlocks.end()) && (iter.key() <= last)) {
+        iter = d->pendingBlocks.erase(iter);
+    }
+}
+
+void MarkdownHighlighter::rehighlightPendingBlocks()
+{
+    Q_D(MarkdownHighlighter);
+
+    QMap<int, QTextBlock> blocks = d->pendingBlocks;
+    d->pendingBlocks.clear();
+
+    foreach (const QTextBlock &block, blocks) {
+        if (block.isValid()) {
+            rehighlightBlock(block);
+        }
+    }
+}
+
+void MarkdownHighlighter::startSpellCheck()
+{
+    Q_D(MarkdownHighlighter);
+
+    d->startSpellCheck();
+}
+
+void MarkdownHighlighterPrivate::spellCheck
+(
+    const QString &text,
+    const QString &prose,
+    uint key
+)
 {
     Q_Q(MarkdownHighlighter);
     
+    QTextBlock block = q->currentBlock();
+    TextBlockData *blockData = currentBlockData();
+
+    // Only the prose in the block is checked, skipping over code, HTML,
+    // URLs, and other markup.
+
+    bool upToDate =
+        (key == blockData->spellCheckKey)
+        && (spellCheckGeneration == blockData->spellCheckGeneration);
+
+    // Spell checking is done in the background.  Until the results come
+    // in, paint the previous results for the words that are still in
+    // place, either at the same position or shifted by the edit.
+    if (!upToDate) {
+        requestSpellCheck(block, blockData, prose, key);
+    } else {
+        // Any check still in progress is for text that is gone, such as
+        // after an undo.  Forget it, so that the text is checked again
+        // should it come back.
+        blockData->pendingSpellCheckKey = 0;
+        blockData->pendingSpellCheckGeneration = -1;
+    }
+
+    int shift = text.length() - blockData->spellCheckTextLength;
     int cursorPosition = editor->textCursor().position();
     QTextBlock cursorPosBlock = q->document()->findBlock(cursorPosition);
     int cursorPosInBlock = -1;
 
-    if (q->currentBlock() == cursorPosBlock) {
+    if (block == cursorPosBlock) {
         cursorPosInBlock = cursorPosition - cursorPosBlock.position();
     }
 
-    QStringRef misspelledWord = dictionary.check(text, 0);
+    foreach (const TextBlockData::Misspelling &misspelling, blockData->misspellings) {
+        int startIndex = misspelling.position;
+        int length = misspelling.word.length();
 
-    while (!misspelledWord.isNull()) {
-        int startIndex = misspelledWord.position();
-        int length = misspelledWord.length();
+        if (text.midRef(startIndex, length) != misspelling.word) {
+            startIndex += shift;
+
+            if
+            (
+                upToDate
+                || (startIndex < 0)
+                || (text.midRef(startIndex, length) != misspelling.word)
+            ) {
+                continue;
+            }
+        }
 
         if (typingPaused || (cursorPosInBlock != (startIndex + length))) {
             QTextCharFormat spellingErrorFormat = q->format(startIndex);
@@ -406,12 +724,305 @@ void MarkdownHighlighterPrivate::spellCheck(const QString &text)
 
             q->setFormat(startIndex, length, spellingErrorFormat);
         }
+    }
+}
+
+void MarkdownHighlighterPrivate::requestSpellCheck
+(
+    const QTextBlock &block,
+    TextBlockData *blockData,
+    const QString &text,
+    uint key
+)
+{
+    Q_Q(MarkdownHighlighter);
+
+    int generation = spellCheckGeneration;
+
+    if
+    (
+        (key == blockData->pendingSpellCheckKey)
+        && (generation == blockData->pendingSpellCheckGeneration)
+    ) {
+        // Already in progress.
+        return;
+    }
+
+    blockData->pendingSpellCheckKey = key;
+    blockData->pendingSpellCheckGeneration = generation;
+
+    SpellCheckRequest request;
+    request.block = block;
+    request.key = key;
+    request.generation = generation;
+    request.text = text;
+    spellCheckRequests.append(request);
+
+    // Collect all the blocks highlighted in this turn of the event loop
+    // (for example, when the whole document is rehighlighted) into one
+    // background job.
+    if (!spellCheckScheduled) {
+        spellCheckScheduled = true;
+        QMetaObject::invokeMethod(q, "startSpellCheck", Qt::QueuedConnection);
+    }
+}
+
+void MarkdownHighlighterPrivate::startSpellCheck()
+{
+    Q_Q(MarkdownHighlighter);
+
+    QVector<SpellCheckRequest> requests;
+    QSet<int> blockNumbers;
+    SpellCheckJob job(DictionaryManager::instance().pin(dictionary));
+
+    spellCheckScheduled = false;
+    job.detector = DictionaryManager::instance().languageDetector();
+
+    // A later request for a block supersedes earlier ones.
+    for (int i = spellCheckRequests.size() - 1; i >= 0; i--) {
+        const SpellCheckRequest &request = spellCheckRequests[i];
+
+        if
+        (
+            request.block.isValid()
+            && !blockNumbers.contains(request.block.blockNumber())
+        ) {
+            blockNumbers.insert(request.block.blockNumber());
+            requests.append(request);
+            job.texts.append(request.text);
+            job.paragraphs.append
+            (
+                job.detector
+                    ? paragraphText(request.block, request.text)
+                    : QString()
+            );
+        }
+    }
+
+    spellCheckRequests.clear();
+
+    if (requests.isEmpty()) {
+        return;
+    }
+
+    if (DictionaryManager::isPending(job.dictionary)) {
+        checkedWithPendingDictionary = true;
+    }
+
+    if (nullptr != job.detector) {
+        job.defaultLanguage = DictionaryManager::instance().defaultLanguage();
+        job.dictionaries = DictionaryManager::instance().residentDictionaries();
+    }
+
+    QFutureWatcher<QVector<SpellCheckResult>> *watcher =
+        new QFutureWatcher<QVector<SpellCheckResult>>(q);
+
+    q->connect
+    (
+        watcher,
+        &QFutureWatcher<QVector<SpellCheckResult>>::finished,
+        [this, watcher, requests]() {
+            QVector<SpellCheckResult> results = watcher->result();
+
+            for (int i = 0; i < requests.size(); i++) {
+                onSpellCheckFinished
+                (
+                    requests[i].block,
+                    requests[i].key,
+                    requests[i].generation,
+                    requests[i].text.length(),
+                    results[i]
+                );
+            }
+
+            watcher->deleteLater();
+        }
+    );
+
+    watcher->setFuture
+    (
+        QtConcurrent::run
+        (
+            &spellCheckPool,
+            &MarkdownHighlighterPrivate::runSpellCheck,
+            job
+        )
+    );
+}
+
+void MarkdownHighlighterPrivate::onSpellCheckFinished
+(
+    const QTextBlock &block,
+    uint key,
+    int generation,
+    int textLength,
+    const SpellCheckResult &result
+)
+{
+    Q_Q(MarkdownHighlighter);
+
+    // Load the dictionary for the detected language if it isn't loaded
+    // yet, or mark it as still in use if it is.  The block is checked
+    // again once the dictionary is ready.
+    if (!result.language.isEmpty()) {
+        DictionaryManager::instance().requestDictionary(result.language);
+    }
+
+    if (!block.isValid()) {
+        return;
+    }
+
+    TextBlockData *blockData = (TextBlockData *) block.userData();
+
+    if (nullptr == blockData) {
+        return;
+    }
+
+    // Discard results for text that has since been edited or for a
+    // dictionary that has since changed.  A newer spell check will
+    // have been requested when the block was rehighlighted.  If this
+    // was the block's pending check, forget it, so that the same text
+    // is checked again should it come back, such as after an undo and
+    // a redo.
+    //
+    if
+    (
+        (generation != spellCheckGeneration)
+        || (key != qHash(blockData->proseText(block.text())))
+    ) {
+        if
+        (
+            (key == blockData->pendingSpellCheckKey)
+            && (generation == blockData->pendingSpellCheckGeneration)
+        ) {
+            blockData->pendingSpellCheckKey = 0;
+            blockData->pendingSpellCheckGeneration = -1;
+        }
+
+        return;
+    }
+
+    blockData->misspellings = result.misspellings;
+    blockData->language = result.language;
+    blockData->spellCheckKey = key;
+    blockData->spellCheckGeneration = generation;
+    blockData->spellCheckTextLength = textLength;
+    blockData->pendingSpellCheckKey = 0;
+    blockData->pendingSpellCheckGeneration = -1;
 
-        startIndex += length;
-        misspelledWord = dictionary.check(text, startIndex);
+    if (spellCheckEnabled) {
+        q->rehighlightBlock(block);
     }
 }
 
+QString MarkdownHighlighterPrivate::paragraphText
+(
+    const QTextBlock &block,
+    const QString &prose
+)
+{
+    // A single line is often too short to tell its language, so use the
+    // prose of the surrounding lines up to the blank lines around them,
+    // within reason.
+    //
+    QStringList lines(prose);
+    int length = prose.length();
+
+    QTextBlock previous = block.previous();
+    QTextBlock next = block.next();
+
+    while (length < GW_PARAGRAPH_SAMPLE_LENGTH) {
+        bool hasPrevious = previous.isValid() && !previous.text().trimmed().isEmpty();
+        bool hasNext = next.isValid() && !next.text().trimmed().isEmpty();
+
+        if (!hasPrevious && !hasNext) {
+            break;
+        }
+
+        if (hasPrevious) {
+            lines.prepend(TextBlockData::proseText(previous));
+            length += lines.first().length();
+            previous = previous.previous();
+        }
+
+        if (hasNext) {
+            lines.append(TextBlockData::proseText(next));
+            length += lines.last().length();
+            next = next.next();
+        }
+    }
+
+    return lines.join(' ');
+}
+
+QVector<SpellCheckResult> MarkdownHighlighterPrivate::runSpellCheck
+(
+    const SpellCheckJob &job
+)
+{
+    QVector<SpellCheckResult> results;
+    results.reserve(job.texts.size());
+
+    for (int i = 0; i < job.texts.size(); i++) {
+        results.append(findMisspellings(job, job.paragraphs[i], job.texts[i]));
+    }
+
+    return results;
+}
+
+SpellCheckResult MarkdownHighlighterPrivate::findMisspellings
+(
+    const SpellCheckJob &job,
+    const QString &paragraph,
+    const QString &text
+)
+{
+    SpellCheckResult result;
+    DictionaryRef dictionary = job.dictionary;
+
+    if (nullptr != job.detector) {
+        QString language = job.detector->detect(paragraph);
+
+        // Regional variants of the default language are checked with the
+        // default dictionary.
+        if
+        (
+            !language.isEmpty()
+            && (language.section('_', 0, 0) != job.defaultLanguage.section('_', 0, 0))
+        ) {
+            result.language = language;
+
+            QHash<QString, DictionaryRef>::const_iterator i =
+                job.dictionaries.constFind(language);
+
+            // Don't check with the wrong dictionary while the right one
+            // is not loaded.
+            if (i == job.dictionaries.constEnd()) {
+                return result;
+            }
+
+            dictionary = i.value();
+        }
+    }
+
+    QStringRef misspelledWord = dictionary.check(text, 0);
+
+    while (!misspelledWord.isNull()) {
+        TextBlockData::Misspelling misspelling;
+        misspelling.position = misspelledWord.position();
+        misspelling.word = misspelledWord.toString();
+        result.misspellings.append(misspelling);
+
+        misspelledWord = dictionary.check
+        (
+            text,
+            misspelling.position + misspelling.word.length()
+        );
+    }
+
+    return result;
+}
+
 void MarkdownHighlighterPrivate::applyFormattingForNode(const MarkdownNode *const node)
 {
     Q_Q(MarkdownHighlighter);
@@ -735,6 +1346,14 @@ void MarkdownHighlighterPrivate::applyFormattingForNode(const MarkdownNode *cons
 
             if (MarkdownNode::Text == type) {
                 highlightRefLinks(pos, length);
+
+                if
+                (
+                    (nullptr == current->parent())
+                    || !current->parent()->isAutolink()
+                ) {
+                    addProseRange(pos, current->length());
+                }
             } else if (MarkdownNode::TaskListItem == type) {
                 format = contextFormat;
                 format.setForeground(colors.link);
@@ -877,6 +1496,48 @@ void MarkdownHighlighterPrivate::highlightRefLinks(const int pos, const int leng
     }
 }
 
+void MarkdownHighlighterPrivate::addProseRange(const int pos, const int length)
+{
+    Q_Q(MarkdownHighlighter);
+
+    int start = qMax(0, pos);
+    int end = qMin(pos + length, q->currentBlock().text().length());
+
+    if (end <= start) {
+        return;
+    }
+
+    // Merge with the previous range if adjacent, as is the case with text
+    // nodes split at delimiter characters (e.g., "snake_case").
+    if (!proseRanges.isEmpty()) {
+        TextBlockData::TextRange &last = proseRanges.last();
+
+        if ((last.position + last.length) == start) {
+            last.length = end - last.position;
+            return;
+        }
+    }
+
+    TextBlockData::TextRange range;
+    range.position = start;
+    range.length = end - start;
+    proseRanges.append(range);
+}
+
+TextBlockData *MarkdownHighlighterPrivate::currentBlockData()
+{
+    Q_Q(MarkdownHighlighter);
+
+    TextBlockData *blockData = (TextBlockData *) q->currentBlockUserData();
+
+    if (nullptr == blockData) {
+        blockData = new TextBlockData((MarkdownDocument *) q->document());
+        q->setCurrentBlockUserData(blockData);
+    }
+
+    return blockData;
+}
+
 bool MarkdownHighlighterPrivate::lineMatchesNode(const int line, const MarkdownNode *const node) const
 {
     return
@@ -155,6 +155,43 @@ private slots:
     */
     void onHighlightBlockAtPosition(int position);
 
+    /*
+    * Invalidates the spell check results of all text blocks, and
+    * rechecks them, since the dictionary's word list has changed.
+    */
+    void onDictionaryChanged();
+
+    /*
+    * Rechecks the text blocks that were spell checked while the
+    * dictionary for the given language was still loading.
+    */
+    void onDictionaryLoaded(const QString &language);
+
+    /*
+    * Queues the text blocks with the given block numbers for
+    * rehighlighting, since the structure of their Markdown nodes
+    * changed after the document was last parsed.
+    */
+    void onMarkdownStructureChanged(const QVector<int> &blockNumbers);
+
+    /*
+    * Removes the text blocks that were just edited from the queue of
+    * blocks to rehighlight, since QSyntaxHighlighter already
+    * highlighted them for the edit.
+    */
+    void onContentsChange(int position, int charsRemoved, int charsAdded);
+
+    /*
+    * Rehighlights the text blocks queued by onMarkdownStructureChanged().
+    */
+    void rehighlightPendingBlocks();
+
+    /*
+    * Spell checks the text blocks queued since the last call in one
+    * background job.
+    */
+    void startSpellCheck();
+
 private:
     QScopedPointer<MarkdownHighlighterPrivate> d_ptr;
 };
@@ -42,6 +42,7 @@ MarkdownNode::MarkdownNode() :
     m_length(0),
     m_fenceChar('\0'),
     m_headingLevel(0),
+    m_autolink(false),
     m_listStartNum(0)
 {
     ;
@@ -93,6 +94,25 @@ void MarkdownNode::setDataFrom(cmark_node *node)
         m_headingLevel = cmark_node_get_heading_level(node);
         m_text = QString::fromUtf8(cmark_node_get_string_content(node));
         m_text = this->m_text.simplified();
+    } else if (Link == m_type) {
+        cmark_node *child = cmark_node_first_child(node);
+
+        if
+        (
+            (NULL != child)
+            && (CMARK_NODE_TEXT == cmark_node_get_type(child))
+            && (NULL == cmark_node_next(child))
+        ) {
+            QString url = QString::fromUtf8(cmark_node_get_url(node));
+            QString text = QString::fromUtf8(cmark_node_get_literal(child));
+
+            // Note that the URL of an autolink may have a scheme that
+            // was implied by the link text (e.g., "mailto:" or "http://").
+            m_autolink =
+                (url == text)
+                || (url == ("mailto:" + text))
+                || url.endsWith("://" + text);
+        }
     }
 }
 
@@ -306,6 +326,11 @@ bool MarkdownNode::isBulletListItem() const
         );
 }
 
+bool MarkdownNode::isAutolink() const
+{
+    return m_autolink;
+}
+
 MarkdownNode::NodeType MarkdownNode::nodeType(cmark_node *node)
 {
     switch (cmark_node_get_type(node)) {
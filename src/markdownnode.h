@@ -225,6 +225,12 @@ public:
      */
     bool isBulletListItem() const;
 
+    /**
+     * Returns true if this node is a link whose text is the URL itself,
+     * such as <https://example.com> or www.example.com.
+     */
+    bool isAutolink() const;
+
 private:
     NodeType m_type;
     MarkdownNode *m_parent;
@@ -248,6 +254,9 @@ private:
     // Heading level if node is a heading.
     unsigned char m_headingLevel;
 
+    // Whether the node is a link whose text is its URL.
+    bool m_autolink;
+
     // Numbered list starting number if node is a numbered list item.
     int m_listStartNum;
 
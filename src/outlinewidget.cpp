@@ -117,7 +117,7 @@ OutlineWidget::OutlineWidget(MarkdownEditor *editor, QWidget *parent)
     this->connect
     (
         (MarkdownDocument *)editor->document(),
-        static_cast<void (MarkdownDocument::*)(const QTextBlock &)>(&MarkdownDocument::textBlockRemoved),
+        &MarkdownDocument::textBlocksRemoved,
         [d]() {
             d->reloadOutline();
         }
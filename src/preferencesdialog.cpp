@@ -456,6 +456,32 @@ QWidget *PreferencesDialogPrivate::initializeSpellCheckTab()
 
     languageGroupLayout->addRow(tr("Dictionary"), dictionaryComboBox);
 
+    QCheckBox *detectLanguageCheckBox = new QCheckBox(tr("Detect language of each paragraph"));
+    detectLanguageCheckBox->setCheckable(true);
+    detectLanguageCheckBox->setChecked(appSettings->languageDetectionEnabled());
+    connect(detectLanguageCheckBox, SIGNAL(toggled(bool)), appSettings, SLOT(setLanguageDetectionEnabled(bool)));
+    languageGroupLayout->addRow(detectLanguageCheckBox);
+
+    QGroupBox *memoryGroupBox = new QGroupBox(tr("Memory"));
+    tabLayout->addWidget(memoryGroupBox);
+
+    QFormLayout *memoryGroupLayout = new QFormLayout();
+    memoryGroupBox->setLayout(memoryGroupLayout);
+
+    QSpinBox *idleTimeoutInput = new QSpinBox();
+    idleTimeoutInput->setRange(1, 1440);
+    idleTimeoutInput->setSuffix(tr(" min"));
+    idleTimeoutInput->setValue(appSettings->dictionaryIdleTimeout());
+    connect(idleTimeoutInput, SIGNAL(valueChanged(int)), appSettings, SLOT(setDictionaryIdleTimeout(int)));
+    memoryGroupLayout->addRow(tr("Unload unused dictionaries after"), idleTimeoutInput);
+
+    QSpinBox *memoryBudgetInput = new QSpinBox();
+    memoryBudgetInput->setRange(0, 4096);
+    memoryBudgetInput->setSuffix(tr(" MB"));
+    memoryBudgetInput->setValue(appSettings->dictionaryMemoryBudget());
+    connect(memoryBudgetInput, SIGNAL(valueChanged(int)), appSettings, SLOT(setDictionaryMemoryBudget(int)));
+    memoryGroupLayout->addRow(tr("Once dictionaries use more than"), memoryBudgetInput);
+
     return tab;
 }
 
@@ -0,0 +1,366 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QImageIOHandler>
+#include <QImageReader>
+#include <QImageWriter>
+#include <QMimeDatabase>
+#include <QPointer>
+#include <QUrlQuery>
+#include <QWebEngineUrlRequestJob>
+#include <QtConcurrentRun>
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+#include <QWebEngineUrlScheme>
+#endif
+
+#include "htmlblockobserver.h"
+#include "previewschemehandler.h"
+
+namespace ghostwriter
+{
+const QByteArray PreviewSchemeHandler::SCHEME = QByteArray("ghostwriter");
+
+// Host of all URLs, so that the page and everything it fetches share
+// the same origin.
+static const QString PREVIEW_HOST = QString("preview");
+
+// Memory allowed for cached local files, in bytes.
+static const int ASSET_CACHE_SIZE = 64 * 1024 * 1024;
+
+// Image widths are rounded up to a multiple of this, so that resizing the
+// preview doesn't cause images to be scaled again for every pixel.
+static const int IMAGE_WIDTH_STEP = 256;
+
+void PreviewSchemeHandler::registerScheme()
+{
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
+    QWebEngineUrlScheme scheme(SCHEME);
+
+    scheme.setSyntax(QWebEngineUrlScheme::Syntax::Host);
+
+    // The page still loads its scripts from qrc, and may refer to
+    // images with absolute file paths.
+    //
+    QWebEngineUrlScheme::Flags flags =
+        QWebEngineUrlScheme::LocalScheme
+        | QWebEngineUrlScheme::LocalAccessAllowed;
+
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
+    flags |= QWebEngineUrlScheme::CorsEnabled;
+#endif
+
+    scheme.setFlags(flags);
+    QWebEngineUrlScheme::registerScheme(scheme);
+#endif
+}
+
+bool PreviewSchemeHandler::isAvailable()
+{
+    // Before Qt 5.14, the web page cannot fetch from custom schemes.
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 14, 0))
+    return true;
+#else
+    return false;
+#endif
+}
+
+QUrl PreviewSchemeHandler::baseUrl(const QString &dirPath)
+{
+    QUrl fileUrl = QUrl::fromLocalFile(dirPath + "/");
+    QUrl url;
+
+    url.setScheme(QString::fromLatin1(SCHEME));
+    url.setHost(PREVIEW_HOST);
+
+    // The host of a UNC path is kept as the start of the URL path, in
+    // the same form as the path itself, i.e. //host/share/...
+    //
+    if (fileUrl.host().isEmpty()) {
+        url.setPath(fileUrl.path());
+    } else {
+        url.setPath("//" + fileUrl.host() + fileUrl.path());
+    }
+
+    return url;
+}
+
+QUrl PreviewSchemeHandler::localUrl(const QUrl &url)
+{
+    if (url.scheme() != QString::fromLatin1(SCHEME)) {
+        return url;
+    }
+
+    QUrl fileUrl;
+
+    if (url.path().startsWith("//")) {
+        fileUrl = QUrl::fromLocalFile(url.path());
+    } else {
+        fileUrl.setScheme("file");
+        fileUrl.setPath(url.path());
+    }
+
+    fileUrl.setFragment(url.fragment());
+
+    return fileUrl;
+}
+
+PreviewSchemeHandler::PreviewSchemeHandler
+(
+    const HtmlBlockObserver *blocks,
+    QObject *parent
+) : QWebEngineUrlSchemeHandler(parent),
+    mBlocks(blocks),
+    mAssets(ASSET_CACHE_SIZE),
+    mMaximumImageWidth(IMAGE_WIDTH_STEP),
+    mBaseUrl(baseUrl(QString()))
+{
+    ;
+}
+
+PreviewSchemeHandler::~PreviewSchemeHandler()
+{
+    ;
+}
+
+void PreviewSchemeHandler::setDocumentDirectory(const QString &dirPath)
+{
+    mDirPath = dirPath.isEmpty() ? QString() : QDir::cleanPath(dirPath);
+    mBaseUrl = baseUrl(dirPath);
+}
+
+void PreviewSchemeHandler::setMaximumImageWidth(int width)
+{
+    int steps = (qMax(width, 1) + IMAGE_WIDTH_STEP - 1) / IMAGE_WIDTH_STEP;
+
+    mMaximumImageWidth = steps * IMAGE_WIDTH_STEP;
+}
+
+void PreviewSchemeHandler::requestStarted(QWebEngineUrlRequestJob *job)
+{
+    if (job->requestMethod() != "GET") {
+        job->fail(QWebEngineUrlRequestJob::RequestDenied);
+        return;
+    }
+
+    QUrl url = job->requestUrl();
+    QUrlQuery query(url);
+
+    if (query.hasQueryItem("block")) {
+        QString html;
+
+        if (!mBlocks->blockHtml(query.queryItemValue("block"), html)) {
+            job->fail(QWebEngineUrlRequestJob::UrlNotFound);
+            return;
+        }
+
+        reply(job, "text/html", html.toUtf8());
+        return;
+    }
+
+    QString filePath = localUrl(url).toLocalFile();
+
+    if (!isServed(filePath)) {
+        job->fail(QWebEngineUrlRequestJob::RequestDenied);
+        return;
+    }
+
+    Asset cached;
+    Asset *cachedAsset = mAssets.object(filePath);
+
+    if (nullptr != cachedAsset) {
+        cached = *cachedAsset;
+    }
+
+    // Reading and scaling images can take a while, so do it in the
+    // background.  The job is deleted if the page cancels the request in
+    // the meantime.
+    //
+    QPointer<QWebEngineUrlRequestJob> pendingJob(job);
+    QFutureWatcher<Asset> *watcher = new QFutureWatcher<Asset>(this);
+
+    this->connect
+    (
+        watcher,
+        &QFutureWatcher<Asset>::finished,
+        [this, watcher, pendingJob, filePath]() {
+            Asset asset = watcher->result();
+            watcher->deleteLater();
+
+            if (asset.fileSize >= 0) {
+                // Files too large for the cache are simply not kept.
+                mAssets.insert(filePath, new Asset(asset), asset.data.size());
+            }
+
+            if (pendingJob.isNull()) {
+                return;
+            }
+
+            if (asset.fileSize < 0) {
+                pendingJob->fail(QWebEngineUrlRequestJob::UrlNotFound);
+            } else {
+                reply(pendingJob, asset.mimeType, asset.data);
+            }
+        }
+    );
+
+    watcher->setFuture
+    (
+        QtConcurrent::run
+        (
+            &PreviewSchemeHandler::loadAsset,
+            filePath,
+            mMaximumImageWidth,
+            cached
+        )
+    );
+}
+
+bool PreviewSchemeHandler::isServed(const QString &filePath) const
+{
+    QString path = QDir::cleanPath(filePath);
+
+    if (!mDirPath.isEmpty()) {
+        QString dirPath = mDirPath.endsWith('/') ? mDirPath : (mDirPath + "/");
+
+        if (path.startsWith(dirPath)) {
+            return true;
+        }
+    }
+
+    foreach (const QString &link, mBlocks->linkedUrls()) {
+        QUrl linkUrl = localUrl(mBaseUrl.resolved(QUrl(link)));
+
+        if (linkUrl.isLocalFile() && (QDir::cleanPath(linkUrl.toLocalFile()) == path)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PreviewSchemeHandler::reply
+(
+    QWebEngineUrlRequestJob *job,
+    const QByteArray &mimeType,
+    const QByteArray &data
+)
+{
+    // The job deletes the buffer along with itself.
+    QBuffer *buffer = new QBuffer(job);
+    buffer->setData(data);
+    job->reply(mimeType, buffer);
+}
+
+PreviewSchemeHandler::Asset PreviewSchemeHandler::loadAsset
+(
+    const QString &filePath,
+    int maximumImageWidth,
+    const Asset &cached
+)
+{
+    QFileInfo fileInfo(filePath);
+
+    if (!fileInfo.isFile()) {
+        return Asset();
+    }
+
+    if
+    (
+        (cached.fileSize >= 0)
+        && (cached.lastModified == fileInfo.lastModified())
+        && (cached.fileSize == fileInfo.size())
+        && (
+            (cached.maximumImageWidth < 0)
+            || (cached.maximumImageWidth == maximumImageWidth)
+        )
+    ) {
+        return cached;
+    }
+
+    Asset asset;
+    asset.lastModified = fileInfo.lastModified();
+
+    QImageReader reader(filePath);
+    QByteArray format = reader.format();
+
+    // Animated and vector images are served as they are.
+    if
+    (
+        reader.canRead()
+        && (format != "gif")
+        && (format != "svg")
+        && (format != "svgz")
+    ) {
+        QSize size = reader.size();
+        bool rotated = reader.transformation() & QImageIOHandler::TransformationRotate90;
+        int displayedWidth = rotated ? size.height() : size.width();
+
+        asset.maximumImageWidth = maximumImageWidth;
+
+        if (displayedWidth > maximumImageWidth) {
+            qreal scale = (qreal) maximumImageWidth / displayedWidth;
+            QByteArray outputFormat = (format == "jpeg") ? "jpeg" : "png";
+
+            reader.setAutoTransform(true);
+            reader.setScaledSize(size * scale);
+
+            QImage image = reader.read();
+
+            if (!image.isNull()) {
+                QBuffer buffer(&asset.data);
+                buffer.open(QIODevice::WriteOnly);
+
+                QImageWriter writer(&buffer, outputFormat);
+                writer.setQuality(90);
+
+                if (writer.write(image)) {
+                    asset.mimeType = "image/" + outputFormat;
+                } else {
+                    asset.data.clear();
+                }
+            }
+        }
+    }
+
+    // Anything that isn't downscaled is served as it is.
+    if (asset.data.isEmpty()) {
+        QFile file(filePath);
+
+        if (!file.open(QIODevice::ReadOnly)) {
+            return Asset();
+        }
+
+        asset.data = file.readAll();
+        asset.mimeType = QMimeDatabase().mimeTypeForFile(fileInfo).name().toUtf8();
+    }
+
+    asset.fileSize = fileInfo.size();
+
+    return asset;
+}
+} // namespace ghostwriter
@@ -0,0 +1,171 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef PREVIEWSCHEMEHANDLER_H
+#define PREVIEWSCHEMEHANDLER_H
+
+#include <QByteArray>
+#include <QCache>
+#include <QDateTime>
+#include <QString>
+#include <QUrl>
+#include <QWebEngineUrlRequestJob>
+#include <QWebEngineUrlSchemeHandler>
+
+namespace ghostwriter
+{
+class HtmlBlockObserver;
+
+/**
+ * Serves the live preview's content to the web page over the
+ * "ghostwriter" URL scheme, so that it doesn't need to go through the web
+ * channel or be fetched again from disk on every reload.
+ *
+ * URLs of the form ghostwriter://preview/?block=KEY return the HTML of
+ * the rendered block having the given key, as given by the
+ * HtmlBlockObserver.  Any other URL maps its path to a local file, such
+ * as an image referenced by the document.  Only files in the document's
+ * directory, or referenced by the rendered blocks, are served.  They are
+ * read in the background and kept in an in-memory cache until they are
+ * modified on disk, and images wider than the preview are downscaled to
+ * its width.
+ */
+class PreviewSchemeHandler : public QWebEngineUrlSchemeHandler
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Name of the URL scheme.
+     */
+    static const QByteArray SCHEME;
+
+    /**
+     * Registers the URL scheme with the web engine.  Must be called
+     * before the QApplication is created.
+     */
+    static void registerScheme();
+
+    /**
+     * Returns true if the scheme can be used by the web page to fetch
+     * the HTML of blocks, which requires Qt 5.14 or greater.
+     */
+    static bool isAvailable();
+
+    /**
+     * Returns the URL to use as the web page's base URL for a document
+     * in the given directory, so that relative links and images in the
+     * document are served by this handler.
+     */
+    static QUrl baseUrl(const QString &dirPath);
+
+    /**
+     * Returns the local file URL for the given URL of this scheme.  Other
+     * URLs are returned unchanged.
+     */
+    static QUrl localUrl(const QUrl &url);
+
+    /**
+     * Constructor.  Takes the observer whose blocks are to be served
+     * as a parameter.
+     */
+    PreviewSchemeHandler
+    (
+        const HtmlBlockObserver *blocks,
+        QObject *parent = nullptr
+    );
+
+    /**
+     * Destructor.
+     */
+    virtual ~PreviewSchemeHandler();
+
+    /**
+     * Sets the directory of the document being previewed, whose files
+     * are served along with those referenced by the rendered blocks.
+     * An empty path serves referenced files only.
+     */
+    void setDocumentDirectory(const QString &dirPath);
+
+    /**
+     * Sets the width in device pixels above which images are downscaled.
+     */
+    void setMaximumImageWidth(int width);
+
+    /**
+     * Overridden method to reply to the given request.
+     */
+    void requestStarted(QWebEngineUrlRequestJob *job);
+
+private:
+    /*
+    * Contents of a local file as served, along with what it was
+    * produced from.  If any of the latter changes, the file is read
+    * again.  The file size is negative if the file could not be read.
+    */
+    struct Asset
+    {
+        Asset() : fileSize(-1), maximumImageWidth(-1) { }
+
+        QByteArray data;
+        QByteArray mimeType;
+        QDateTime lastModified;
+        qint64 fileSize;
+        int maximumImageWidth;
+    };
+
+    const HtmlBlockObserver *mBlocks;
+    QCache<QString, Asset> mAssets;
+    int mMaximumImageWidth;
+    QString mDirPath;
+    QUrl mBaseUrl;
+
+    /*
+    * Returns true if the local file at the given path may be served,
+    * that is, if it is in the document's directory or referenced by the
+    * rendered blocks.
+    */
+    bool isServed(const QString &filePath) const;
+
+    /*
+    * Replies to the given job with the given data.
+    */
+    static void reply
+    (
+        QWebEngineUrlRequestJob *job,
+        const QByteArray &mimeType,
+        const QByteArray &data
+    );
+
+    /*
+    * Reads the local file at the given path, downscaled if it is an
+    * image that is too wide, unless the cached asset is still up to
+    * date.  Runs in the background.
+    */
+    static Asset loadAsset
+    (
+        const QString &filePath,
+        int maximumImageWidth,
+        const Asset &cached
+    );
+};
+} // namespace ghostwriter
+
+#endif // PREVIEWSCHEMEHANDLER_H
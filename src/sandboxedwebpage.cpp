@@ -19,6 +19,7 @@
 
 #include <QDesktopServices>
 
+#include "previewschemehandler.h"
 #include "sandboxedwebpage.h"
 
 namespace ghostwriter
@@ -44,7 +45,10 @@ bool SandboxedWebPage::acceptNavigationRequest
     Q_UNUSED(isMainFrame)
 
     if (QWebEnginePage::NavigationTypeLinkClicked == type) {
-        QDesktopServices::openUrl(url);
+        // Links relative to the document are resolved by the preview's
+        // URL scheme, but are opened as the local files they refer to.
+        //
+        QDesktopServices::openUrl(PreviewSchemeHandler::localUrl(url));
         return false;
     } else {
         return true;
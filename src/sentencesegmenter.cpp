@@ -0,0 +1,253 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include <QSet>
+
+#include "sentencesegmenter.h"
+#include "textblockdata.h"
+
+namespace ghostwriter
+{
+namespace
+{
+// Abbreviations that are usually followed by a period without ending the
+// sentence, in lowercase and without their final period.
+const QSet<QString> &abbreviations()
+{
+    static const QSet<QString> table =
+    {
+        "mr", "mrs", "ms", "mx", "dr", "prof", "sr", "jr", "st", "mt",
+        "rev", "hon", "gen", "col", "capt", "lt", "sgt", "gov", "pres",
+        "vs", "cf", "e.g", "i.e", "viz", "approx", "ca", "fig", "figs",
+        "no", "nos", "vol", "vols", "p", "pp", "ch", "sec", "ed", "eds",
+        "inc", "ltd", "co", "corp", "dept", "univ", "jan", "feb", "mar",
+        "apr", "jun", "jul", "aug", "sep", "sept", "oct", "nov", "dec"
+    };
+
+    return table;
+}
+
+inline bool isSpace(ushort ucs)
+{
+    if (ucs < 128) {
+        return (' ' == ucs) || ((ucs >= '\t') && (ucs <= '\r'));
+    }
+
+    return QChar(ucs).isSpace();
+}
+
+inline bool isHardBreak(ushort ucs)
+{
+    return ('\n' == ucs) || (QChar::LineSeparator == ucs) || (QChar::ParagraphSeparator == ucs);
+}
+
+inline bool isTerminal(ushort ucs)
+{
+    switch (ucs) {
+    case '.':
+    case '!':
+    case '?':
+    case 0x2026: // Horizontal ellipsis
+    case 0x203C: // Double exclamation mark
+    case 0x203D: // Interrobang
+    case 0x3002: // Ideographic full stop
+    case 0xFF01: // Fullwidth exclamation mark
+    case 0xFF0E: // Fullwidth full stop
+    case 0xFF1F: // Fullwidth question mark
+        return true;
+    default:
+        return false;
+    }
+}
+
+inline bool isClosing(ushort ucs)
+{
+    if (ucs < 128) {
+        return ('"' == ucs) || ('\'' == ucs) || (')' == ucs) || (']' == ucs) || ('*' == ucs) || ('_' == ucs);
+    }
+
+    QChar::Category category = QChar(ucs).category();
+
+    return (QChar::Punctuation_Close == category)
+        || (QChar::Punctuation_FinalQuote == category)
+        || (QChar::Punctuation_InitialQuote == category);
+}
+
+inline bool isLower(ushort ucs)
+{
+    if (ucs < 128) {
+        return (ucs >= 'a') && (ucs <= 'z');
+    }
+
+    return QChar(ucs).isLower();
+}
+
+// Returns true if the period at the given position follows an
+// abbreviation or an initial rather than ending a sentence.
+bool isAbbreviation(const QString &text, int periodPos)
+{
+    int start = periodPos;
+
+    while ((start > 0) && (text[start - 1].isLetter() || ('.' == text[start - 1]))) {
+        start--;
+    }
+
+    if (start == periodPos) {
+        return false;
+    }
+
+    QString word = text.mid(start, periodPos - start);
+
+    // Initials, such as the "J" in "J. R. R. Tolkien".
+    if ((1 == word.length()) && word[0].isUpper()) {
+        return true;
+    }
+
+    return abbreviations().contains(word.toLower());
+}
+} // namespace
+
+QVector<int> SentenceSegmenter::boundaries(const QString &text)
+{
+    QVector<int> result;
+    const ushort *chars = text.utf16();
+    int length = text.length();
+    int i = 0;
+
+    result.append(0);
+
+    while (i < length) {
+        ushort ucs = chars[i];
+
+        if (isHardBreak(ucs)) {
+            i++;
+
+            if (i < length) {
+                result.append(i);
+            }
+
+            continue;
+        }
+
+        if (!isTerminal(ucs)) {
+            i++;
+            continue;
+        }
+
+        // Include runs of terminal punctuation, such as "?!" or "...",
+        // and any closing quotes, brackets, or emphasis markup.
+        int end = i + 1;
+
+        while ((end < length) && isTerminal(chars[end])) {
+            end++;
+        }
+
+        while ((end < length) && isClosing(chars[end])) {
+            end++;
+        }
+
+        // Punctuation within a word or number, such as "3.14", doesn't
+        // end the sentence.
+        if ((end >= length) || !isSpace(chars[end])) {
+            i = end;
+            continue;
+        }
+
+        int next = end;
+
+        while ((next < length) && isSpace(chars[next]) && !isHardBreak(chars[next])) {
+            next++;
+        }
+
+        if ((next >= length) || isHardBreak(chars[next])) {
+            i = next;
+            continue;
+        }
+
+        bool sentenceEnds = true;
+        bool ellipsis = ((i + 1) < end) && ('.' == chars[i + 1]);
+
+        if (('.' == ucs) && !ellipsis) {
+            sentenceEnds = !isAbbreviation(text, i) && !isLower(chars[next]);
+        }
+
+        if (sentenceEnds) {
+            result.append(next);
+        }
+
+        i = next;
+    }
+
+    if (result.last() != length) {
+        result.append(length);
+    }
+
+    return result;
+}
+
+QVector<int> SentenceSegmenter::boundaries(const QTextBlock &block)
+{
+    TextBlockData *blockData = (TextBlockData *) block.userData();
+
+    if (nullptr == blockData) {
+        return boundaries(block.text());
+    }
+
+    // The block's revision changes whenever its text does, so a cache hit
+    // costs neither a copy of the text nor a pass over it.
+    //
+    if (block.revision() != blockData->sentenceBoundariesRevision) {
+        blockData->sentenceBoundaries = boundaries(block.text());
+        blockData->sentenceBoundariesRevision = block.revision();
+    }
+
+    return blockData->sentenceBoundaries;
+}
+
+int SentenceSegmenter::countSentences(const QString &text)
+{
+    return countSentences(text, boundaries(text));
+}
+
+int SentenceSegmenter::countSentences
+(
+    const QString &text,
+    const QVector<int> &boundaries
+)
+{
+    const ushort *chars = text.utf16();
+    int length = text.length();
+    int count = 0;
+
+    for (int i = 1; i < boundaries.size(); i++) {
+        int start = qMax(boundaries[i - 1], 0);
+        int end = qMin(boundaries[i], length);
+
+        for (int j = start; j < end; j++) {
+            if (!isSpace(chars[j]) && !isHardBreak(chars[j])) {
+                count++;
+                break;
+            }
+        }
+    }
+
+    return count;
+}
+} // namespace ghostwriter
@@ -0,0 +1,70 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef SENTENCE_SEGMENTER_H
+#define SENTENCE_SEGMENTER_H
+
+#include <QString>
+#include <QTextBlock>
+#include <QVector>
+
+namespace ghostwriter
+{
+/**
+ * Lightweight, rule-based sentence segmenter.  Sentences end at terminal
+ * punctuation followed by whitespace, except after common abbreviations,
+ * initials, or when the next sentence would begin with a lowercase letter.
+ * ASCII text is handled without Unicode table lookups.
+ */
+class SentenceSegmenter
+{
+public:
+    /**
+     * Returns the positions of the sentence boundaries in the text,
+     * starting with 0 and ending with the length of the text.  Each
+     * sentence starts at a boundary and includes the whitespace after it.
+     */
+    static QVector<int> boundaries(const QString &text);
+
+    /**
+     * Returns the sentence boundaries of the given block's text.  The
+     * boundaries are cached in the block's TextBlockData, if it has any,
+     * until the block's text changes.
+     */
+    static QVector<int> boundaries(const QTextBlock &block);
+
+    /**
+     * Returns the number of sentences with non-whitespace text in them.
+     */
+    static int countSentences(const QString &text);
+
+    /**
+     * Returns the number of sentences with non-whitespace text in them,
+     * given sentence boundaries already found for the text.
+     */
+    static int countSentences
+    (
+        const QString &text,
+        const QVector<int> &boundaries
+    );
+};
+} // namespace ghostwriter
+
+#endif
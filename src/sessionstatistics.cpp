@@ -44,6 +44,7 @@ void SessionStatistics::startNewSession(int initialWordCount)
     sessionWordCount = 0;
     totalWordsWritten = 0;
     lastWordCount = initialWordCount;
+    sessionStartPending = false;
     totalSeconds = 0;
     idleSeconds = 0;
     idle = true;
@@ -57,8 +58,19 @@ void SessionStatistics::startNewSession(int initialWordCount)
     emit idleTimePercentageChanged(100);
 }
 
+void SessionStatistics::startNewSessionOnWordCount()
+{
+    startNewSession(0);
+    sessionStartPending = true;
+}
+
 void SessionStatistics::onDocumentWordCountChanged(int newWordCount)
 {
+    if (sessionStartPending) {
+        startNewSession(newWordCount);
+        return;
+    }
+
     int deltaWords = newWordCount - lastWordCount;
 
     if (deltaWords > 0) {
@@ -77,6 +77,14 @@ public slots:
      */
     void startNewSession(int lastWordCount = 0);
 
+    /**
+     * Resets statistics for a new writing session that starts with the
+     * next document word count received, for when the word count of a
+     * newly loaded document isn't known yet.  Until then, no words are
+     * counted as written.
+     */
+    void startNewSessionOnWordCount();
+
     void onDocumentWordCountChanged(int newWordCount);
     void onTypingPaused();
     void onTypingResumed();
@@ -88,6 +96,7 @@ private:
     int sessionWordCount;
     int totalWordsWritten;
     int lastWordCount;
+    bool sessionStartPending;
     QTimer *sessionTimer;
     bool idle;
     unsigned long totalSeconds;
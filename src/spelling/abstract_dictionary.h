@@ -23,6 +23,7 @@
 class QString;
 class QStringList;
 class QStringRef;
+class VerdictCache;
 
 class AbstractDictionary
 {
@@ -36,6 +37,11 @@ public:
 	virtual void addToPersonal(const QString& word) = 0;
 	virtual void addToSession(const QStringList& words) = 0;
 	virtual void removeFromSession(const QStringList& words) = 0;
+
+	virtual const VerdictCache* verdictCache() const
+	{
+		return 0;
+	}
 };
 
 #endif
@@ -0,0 +1,145 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include "bk_tree.h"
+
+#include <QPair>
+
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+
+BKTree::BKTree()
+{
+}
+
+//-----------------------------------------------------------------------------
+
+void BKTree::insert(const QString& word)
+{
+	Node node;
+	node.word = word;
+	node.key = word.toCaseFolded();
+
+	if (m_nodes.isEmpty()) {
+		m_nodes.append(node);
+		return;
+	}
+
+	// Walk down the edges matching the distance to each node until a node
+	// without such an edge is found, and hang the word off of it
+	int index = 0;
+	forever {
+		int d = distance(node.key, m_nodes.at(index).key);
+		if ((d == 0) && (m_nodes.at(index).word == word)) {
+			return;
+		}
+
+		int child = -1;
+		foreach (const auto& edge, m_nodes.at(index).children) {
+			if (edge.first == d) {
+				child = edge.second;
+				break;
+			}
+		}
+
+		if (child == -1) {
+			m_nodes[index].children.append(qMakePair(d, m_nodes.size()));
+			m_nodes.append(node);
+			return;
+		}
+		index = child;
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+QStringList BKTree::find(const QString& word, int max_distance) const
+{
+	QVector<QPair<int, QString> > matches;
+	if (m_nodes.isEmpty()) {
+		return QStringList();
+	}
+
+	QString key = word.toCaseFolded();
+	QVector<int> pending;
+	pending.append(0);
+	while (!pending.isEmpty()) {
+		const Node& node = m_nodes.at(pending.takeLast());
+		int d = distance(key, node.key);
+		if ((d <= max_distance) && (node.word != word)) {
+			matches.append(qMakePair(d, node.word));
+		}
+
+		// By the triangle inequality, only subtrees whose edge distance is
+		// within max_distance of d can contain matches
+		foreach (const auto& edge, node.children) {
+			if (qAbs(edge.first - d) <= max_distance) {
+				pending.append(edge.second);
+			}
+		}
+	}
+
+	// Closest matches first
+	std::stable_sort(matches.begin(), matches.end(), [](const QPair<int, QString>& m1, const QPair<int, QString>& m2) {
+		return m1.first < m2.first;
+	});
+
+	QStringList result;
+	foreach (const auto& match, matches) {
+		result.append(match.second);
+	}
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+
+void BKTree::clear()
+{
+	m_nodes.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+int BKTree::distance(const QString& s1, const QString& s2)
+{
+	// Levenshtein distance, keeping only two rows of the matrix
+	int length1 = s1.length();
+	int length2 = s2.length();
+	QVector<int> previous(length2 + 1);
+	QVector<int> current(length2 + 1);
+	for (int j = 0; j <= length2; ++j) {
+		previous[j] = j;
+	}
+
+	for (int i = 1; i <= length1; ++i) {
+		current[0] = i;
+		QChar c = s1.at(i - 1);
+		for (int j = 1; j <= length2; ++j) {
+			int cost = (c == s2.at(j - 1)) ? 0 : 1;
+			current[j] = std::min(std::min(previous[j] + 1, current[j - 1] + 1), previous[j - 1] + cost);
+		}
+		previous.swap(current);
+	}
+
+	return previous[length2];
+}
+
+//-----------------------------------------------------------------------------
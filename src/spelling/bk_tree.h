@@ -0,0 +1,59 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef BK_TREE_H
+#define BK_TREE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * Burkhard-Keller tree of words, indexed by their edit distance from each
+ * other.  Finds all words within a given edit distance of a misspelled word
+ * without comparing it against every word in the tree.
+ */
+class BKTree
+{
+public:
+	BKTree();
+
+	void insert(const QString& word);
+	QStringList find(const QString& word, int max_distance) const;
+	void clear();
+
+	bool isEmpty() const
+	{
+		return m_nodes.isEmpty();
+	}
+
+	static int distance(const QString& s1, const QString& s2);
+
+private:
+	struct Node
+	{
+		QString word;
+		QString key;
+		QVector<QPair<int, int> > children;
+	};
+	QVector<Node> m_nodes;
+};
+
+#endif
@@ -26,10 +26,15 @@
 #include "dictionary_provider_nsspellchecker.h"
 #endif
 #include "dictionary_ref.h"
+#include "language_detector.h"
 
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QPair>
 #include <QTextStream>
+#include <QTimer>
+#include <QtConcurrentRun>
 
 #include <algorithm>
 
@@ -43,6 +48,19 @@ bool compareWords(const QString& s1, const QString& s2)
 	return s1.localeAwareCompare(s2) < 0;
 }
 
+// Number of journaled changes to the personal dictionary after which the
+// personal word file is rewritten and the journal discarded.
+const int MAX_JOURNAL_ENTRIES = 100;
+
+// Interval in milliseconds at which idle dictionaries are evicted.
+const int EVICTION_INTERVAL = 60000;
+
+// Deleter for the placeholder dictionaries, which are never deleted.
+void keepDictionary(AbstractDictionary* dictionary)
+{
+	Q_UNUSED(dictionary);
+}
+
 class DictionaryFallback : public AbstractDictionary
 {
 public:
@@ -92,6 +110,57 @@ private:
 	}
 };
 
+// Stands in for a dictionary that is still being loaded in the background,
+// or that was evicted to save memory, reporting no misspelled words until
+// the real dictionary takes its place.
+class DictionaryPending : public AbstractDictionary
+{
+public:
+	static AbstractDictionary* instance()
+	{
+		static DictionaryPending pending;
+		return &pending;
+	}
+
+	bool isValid() const
+	{
+		return true;
+	}
+
+	QStringRef check(const QString& string, int start_at) const
+	{
+		Q_UNUSED(string);
+		Q_UNUSED(start_at);
+		return QStringRef();
+	}
+
+	QStringList suggestions(const QString& word) const
+	{
+		Q_UNUSED(word);
+		return QStringList();
+	}
+
+	void addToPersonal(const QString& word)
+	{
+		DictionaryManager::instance().add(word);
+	}
+
+	void addToSession(const QStringList& words)
+	{
+		Q_UNUSED(words);
+	}
+
+	void removeFromSession(const QStringList& words)
+	{
+		Q_UNUSED(words);
+	}
+
+private:
+	DictionaryPending()
+	{
+	}
+};
+
 }
 
 QString DictionaryManager::m_path;
@@ -134,12 +203,26 @@ QString DictionaryManager::availableDictionary(const QString& language) const
 
 void DictionaryManager::add(const QString& word)
 {
-	QStringList words = personal();
-    if (words.contains(word)) {
+	QStringList::iterator i = findPersonal(word);
+	if ((i != m_personal.end()) && (*i == word)) {
 		return;
 	}
-	words.append(word);
-	setPersonal(words);
+
+	// Insert into sorted position
+	m_personal.insert(i, word);
+	if (!m_personal_index.isEmpty()) {
+		m_personal_index.insert(word);
+	}
+
+	// Add word to personal dictionary of loaded dictionaries
+	QStringList words(word);
+	foreach (AbstractDictionary* dictionary, m_dictionaries) {
+		dictionary->addToSession(words);
+	}
+	journalPersonal(QLatin1Char('+'), word);
+
+	// Re-check documents
+	emit changed();
 }
 
 //-----------------------------------------------------------------------------
@@ -181,6 +264,85 @@ void DictionaryManager::addProviders()
 
 //-----------------------------------------------------------------------------
 
+void DictionaryManager::remove(const QString& word)
+{
+	QStringList::iterator i = findPersonal(word);
+	if ((i == m_personal.end()) || (*i != word)) {
+		return;
+	}
+
+	m_personal.erase(i);
+	m_personal_index.clear();
+
+	// Remove word from personal dictionary of loaded dictionaries
+	QStringList words(word);
+	foreach (AbstractDictionary* dictionary, m_dictionaries) {
+		dictionary->removeFromSession(words);
+	}
+	journalPersonal(QLatin1Char('-'), word);
+
+	// Re-check documents
+	emit changed();
+}
+
+//-----------------------------------------------------------------------------
+
+QStringList DictionaryManager::personalSuggestions(const QString& word) const
+{
+	// Index is built on first use, and rebuilt after words are removed
+	if (m_personal_index.isEmpty()) {
+		foreach (const QString& personal_word, m_personal) {
+			m_personal_index.insert(personal_word);
+		}
+	}
+
+	int max_distance = (word.length() > 4) ? 2 : 1;
+	return m_personal_index.find(word, max_distance);
+}
+
+//-----------------------------------------------------------------------------
+
+const LanguageDetector* DictionaryManager::languageDetector() const
+{
+	return m_detect_language ? m_detector : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+QHash<QString, DictionaryRef> DictionaryManager::residentDictionaries()
+{
+	QHash<QString, DictionaryRef> result;
+	for (QHash<QString, AbstractDictionary*>::const_iterator i = m_dictionaries.constBegin(); i != m_dictionaries.constEnd(); ++i) {
+		result.insert(i.key(), pinned(i.value()));
+	}
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+
+DictionaryRef DictionaryManager::pin(const DictionaryRef& dictionary)
+{
+	if (!dictionary.m_pinned.isNull()) {
+		return dictionary;
+	}
+
+	// Pinning is done for each use in the background, so it keeps the
+	// dictionary from being evicted while it is in use
+	if (dictionary.d == &m_default_dictionary) {
+		m_last_used[m_default_language] = m_clock.elapsed();
+	} else {
+		for (QHash<QString, AbstractDictionary*>::const_iterator i = m_dictionaries.constBegin(); i != m_dictionaries.constEnd(); ++i) {
+			if (dictionary.d == &i.value()) {
+				m_last_used[i.key()] = m_clock.elapsed();
+				break;
+			}
+		}
+	}
+	return pinned(*dictionary.d);
+}
+
+//-----------------------------------------------------------------------------
+
 DictionaryRef DictionaryManager::requestDictionary(const QString& language)
 {
 	if (language.isEmpty()) {
@@ -212,6 +374,41 @@ void DictionaryManager::setDefaultLanguage(const QString& language)
 
 //-----------------------------------------------------------------------------
 
+void DictionaryManager::setDetectLanguage(bool detect)
+{
+	if (detect == m_detect_language) {
+		return;
+	}
+	m_detect_language = detect;
+
+	if (detect && !m_detector && !m_detector_watcher) {
+		// Profile the default language first, so that it is the one used
+		// for its regional variants
+		QStringList languages = availableDictionaries();
+		languages.removeAll(m_default_language);
+		languages.prepend(m_default_language);
+
+		m_detector_watcher = new QFutureWatcher<LanguageDetector*>(this);
+		connect(m_detector_watcher, &QFutureWatcher<LanguageDetector*>::finished, this, &DictionaryManager::detectorBuilt);
+		m_detector_watcher->setFuture(QtConcurrent::run(&LanguageDetector::build, languages));
+	}
+
+	// Re-check documents
+	if (m_detector) {
+		emit changed();
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::setEvictionPolicy(int idle_minutes, int budget_megabytes)
+{
+	m_idle_timeout = qint64(idle_minutes) * 60000;
+	m_memory_budget = qint64(budget_megabytes) * 1024 * 1024;
+}
+
+//-----------------------------------------------------------------------------
+
 void DictionaryManager::setIgnoreNumbers(bool ignore)
 {
 	foreach (AbstractDictionaryProvider* provider, m_providers) {
@@ -236,6 +433,13 @@ void DictionaryManager::setIgnoreUppercase(bool ignore)
 
 //-----------------------------------------------------------------------------
 
+bool DictionaryManager::isPending(const DictionaryRef& dictionary)
+{
+	return dictionary.dictionary() == DictionaryPending::instance();
+}
+
+//-----------------------------------------------------------------------------
+
 QString DictionaryManager::installedPath()
 {
 #ifndef Q_OS_MAC
@@ -270,14 +474,8 @@ void DictionaryManager::setPersonal(const QStringList& words)
 
 	// Update and store personal dictionary
 	m_personal = personal;
-	QFile file(m_path + "/personal");
-	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-		QTextStream stream(&file);
-		stream.setCodec("UTF-8");
-		foreach (const QString& word, m_personal) {
-			stream << word << "\n";
-		}
-	}
+	m_personal_index.clear();
+	writePersonal();
 
 	// Add personal dictionary
 	foreach (AbstractDictionary* dictionary, m_dictionaries) {
@@ -290,10 +488,22 @@ void DictionaryManager::setPersonal(const QStringList& words)
 
 //-----------------------------------------------------------------------------
 
-DictionaryManager::DictionaryManager()
+DictionaryManager::DictionaryManager() :
+	m_default_dictionary(0),
+	m_journal_entries(0),
+	m_detector(0),
+	m_detector_watcher(0),
+	m_detect_language(false),
+	m_idle_timeout(10 * 60000),
+	m_memory_budget(200 * 1024 * 1024)
 {
 	addProviders();
 
+	m_clock.start();
+	m_eviction_timer = new QTimer(this);
+	connect(m_eviction_timer, &QTimer::timeout, this, &DictionaryManager::evictIdleDictionaries);
+	m_eviction_timer->start(EVICTION_INTERVAL);
+
 	// Load personal dictionary
 	QFile file(m_path + "/personal");
 	if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -304,16 +514,56 @@ DictionaryManager::DictionaryManager()
 		}
 		std::sort(m_personal.begin(), m_personal.end(), compareWords);
 	}
+
+	// Replay changes made since the personal word file was last written
+	QFile journal(m_path + "/personal.journal");
+	if (journal.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		QTextStream stream(&journal);
+		stream.setCodec("UTF-8");
+		while (!stream.atEnd()) {
+			QString line = stream.readLine();
+			if (line.length() < 2) {
+				continue;
+			}
+			QString word = line.mid(1);
+			QStringList::iterator i = findPersonal(word);
+			bool found = (i != m_personal.end()) && (*i == word);
+			if ((line.at(0) == QLatin1Char('+')) && !found) {
+				m_personal.insert(i, word);
+			} else if ((line.at(0) == QLatin1Char('-')) && found) {
+				m_personal.erase(i);
+			}
+			++m_journal_entries;
+		}
+		journal.close();
+
+		if (m_journal_entries > 0) {
+			writePersonal();
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
 
 DictionaryManager::~DictionaryManager()
 {
-	foreach (AbstractDictionary* dictionary, m_dictionaries) {
-		delete dictionary;
+	foreach (QFutureWatcher<AbstractDictionary*>* watcher, m_loading) {
+		watcher->disconnect(this);
+		watcher->waitForFinished();
+		delete watcher->result();
 	}
+	m_loading.clear();
+
+	if (m_detector_watcher) {
+		m_detector_watcher->disconnect(this);
+		m_detector_watcher->waitForFinished();
+		delete m_detector_watcher->result();
+	}
+	delete m_detector;
+	m_detector = 0;
+
 	m_dictionaries.clear();
+	m_owned.clear();
 
 	qDeleteAll(m_providers);
 	m_providers.clear();
@@ -335,25 +585,213 @@ void DictionaryManager::addProvider(AbstractDictionaryProvider* provider)
 
 AbstractDictionary** DictionaryManager::requestDictionaryData(const QString& language)
 {
-	if (!m_dictionaries.contains(language)) {
-		AbstractDictionary* dictionary = 0;
-		foreach (AbstractDictionaryProvider* provider, m_providers) {
-			dictionary = provider->requestDictionary(language);
-			if (dictionary && dictionary->isValid()) {
-				break;
-			} else {
-				delete dictionary;
-				dictionary = 0;
-			}
+	m_last_used[language] = m_clock.elapsed();
+
+	// A placeholder that is not being loaded was evicted, and is reloaded
+	// in the same slot, so that references to it stay valid
+	if (!m_dictionaries.contains(language)
+			|| ((m_dictionaries.value(language) == DictionaryPending::instance()) && !m_loading.contains(language))) {
+		// Loading a dictionary can take a while for large languages, so
+		// load it in the background, with a placeholder in its place in
+		// the meantime.  Users of the dictionary are notified through the
+		// changed() signal once it is ready.
+		m_dictionaries[language] = DictionaryPending::instance();
+
+		QFutureWatcher<AbstractDictionary*>* watcher = new QFutureWatcher<AbstractDictionary*>(this);
+		connect(watcher, &QFutureWatcher<AbstractDictionary*>::finished, this, [this, language]() {
+			dictionaryLoaded(language);
+		});
+		m_loading.insert(language, watcher);
+		m_loading_personal.insert(language, m_personal);
+		watcher->setFuture(QtConcurrent::run(&DictionaryManager::loadDictionary, m_providers, language, m_personal));
+	}
+	return &m_dictionaries[language];
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::dictionaryLoaded(const QString& language)
+{
+	QFutureWatcher<AbstractDictionary*>* watcher = m_loading.take(language);
+	QStringList personal = m_loading_personal.take(language);
+	if (!watcher) {
+		return;
+	}
+	AbstractDictionary* dictionary = watcher->result();
+	watcher->deleteLater();
+
+	if (!dictionary) {
+		dictionary = *DictionaryFallback::instance();
+	} else {
+		m_owned.insert(dictionary, QSharedPointer<AbstractDictionary>(dictionary));
+		if (personal != m_personal) {
+			// Personal dictionary changed while loading
+			dictionary->removeFromSession(personal);
+			dictionary->addToSession(m_personal);
+		}
+	}
+
+	m_dictionaries[language] = dictionary;
+	if (language == m_default_language) {
+		m_default_dictionary = dictionary;
+	}
+
+	// Re-check text checked while the dictionary was pending
+	emit loaded(language);
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::detectorBuilt()
+{
+	m_detector = m_detector_watcher->result();
+	m_detector_watcher->deleteLater();
+	m_detector_watcher = 0;
+
+	// Re-check documents
+	if (m_detect_language) {
+		emit changed();
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::evictIdleDictionaries()
+{
+	qint64 now = m_clock.elapsed();
+	qint64 total = 0;
+	QList<QPair<qint64, QString> > idle;
+	for (QHash<QString, AbstractDictionary*>::const_iterator i = m_dictionaries.constBegin(); i != m_dictionaries.constEnd(); ++i) {
+		if (isPlaceholder(i.value())) {
+			continue;
 		}
+		total += estimatedSize(i.key());
 
-		if (!dictionary) {
-			return DictionaryFallback::instance();
+		qint64 last_used = m_last_used.value(i.key());
+		if ((i.key() != m_default_language) && ((now - last_used) >= m_idle_timeout)) {
+			idle.append(qMakePair(last_used, i.key()));
 		}
-		dictionary->addToSession(m_personal);
-		m_dictionaries[language] = dictionary;
 	}
-	return &m_dictionaries[language];
+
+	// Evict least recently used dictionaries first, until under budget.
+	// Background spell checks still using one hold a pinned reference to
+	// it, and the last of them deletes it.
+	std::sort(idle.begin(), idle.end());
+	for (int i = 0; (i < idle.size()) && (total > m_memory_budget); ++i) {
+		const QString& language = idle.at(i).second;
+		AbstractDictionary*& dictionary = m_dictionaries[language];
+		m_owned.remove(dictionary);
+		dictionary = DictionaryPending::instance();
+		total -= estimatedSize(language);
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+qint64 DictionaryManager::estimatedSize(const QString& language)
+{
+	// Dictionaries take up memory roughly in proportion to the size of their
+	// word list and affix files, which is much cheaper to find out
+	if (!m_sizes.contains(language)) {
+		qint64 size = QFileInfo("dict:" + language + ".dic").size() + QFileInfo("dict:" + language + ".aff").size();
+		m_sizes.insert(language, (size > 0) ? (size * 2) : (1024 * 1024));
+	}
+	return m_sizes.value(language);
+}
+
+//-----------------------------------------------------------------------------
+
+QStringList::iterator DictionaryManager::findPersonal(const QString& word)
+{
+	// Binary search for the word, or for the position to insert it at.
+	// Note that distinct words may compare as equal, so check all of them.
+	QStringList::iterator i = std::lower_bound(m_personal.begin(), m_personal.end(), word, compareWords);
+	QStringList::iterator first = i;
+	while ((i != m_personal.end()) && !compareWords(word, *i)) {
+		if (*i == word) {
+			return i;
+		}
+		++i;
+	}
+	return first;
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::journalPersonal(QChar operation, const QString& word)
+{
+	if (++m_journal_entries > MAX_JOURNAL_ENTRIES) {
+		writePersonal();
+		return;
+	}
+
+	QFile file(m_path + "/personal.journal");
+	if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+		QTextStream stream(&file);
+		stream.setCodec("UTF-8");
+		stream << operation << word << "\n";
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+void DictionaryManager::writePersonal()
+{
+	QFile file(m_path + "/personal");
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		QTextStream stream(&file);
+		stream.setCodec("UTF-8");
+		foreach (const QString& word, m_personal) {
+			stream << word << "\n";
+		}
+		stream.flush();
+		file.close();
+
+		// Personal word file is up to date, so journal is no longer needed
+		QFile::remove(m_path + "/personal.journal");
+		m_journal_entries = 0;
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+bool DictionaryManager::isPlaceholder(AbstractDictionary* dictionary) const
+{
+	return (dictionary == DictionaryPending::instance())
+			|| (dictionary == *DictionaryFallback::instance());
+}
+
+//-----------------------------------------------------------------------------
+
+DictionaryRef DictionaryManager::pinned(AbstractDictionary* dictionary) const
+{
+	QSharedPointer<AbstractDictionary> owned = m_owned.value(dictionary);
+	if (owned.isNull()) {
+		owned = QSharedPointer<AbstractDictionary>(dictionary, keepDictionary);
+	}
+	return DictionaryRef(owned);
+}
+
+//-----------------------------------------------------------------------------
+
+AbstractDictionary* DictionaryManager::loadDictionary(const QList<AbstractDictionaryProvider*>& providers,
+		const QString& language, const QStringList& personal)
+{
+	AbstractDictionary* dictionary = 0;
+	foreach (AbstractDictionaryProvider* provider, providers) {
+		dictionary = provider->requestDictionary(language);
+		if (dictionary && dictionary->isValid()) {
+			break;
+		} else {
+			delete dictionary;
+			dictionary = 0;
+		}
+	}
+
+	if (dictionary) {
+		dictionary->addToSession(personal);
+	}
+	return dictionary;
 }
 
 //-----------------------------------------------------------------------------
@@ -23,10 +23,17 @@
 class AbstractDictionary;
 class AbstractDictionaryProvider;
 class DictionaryRef;
+class LanguageDetector;
 
+#include "bk_tree.h"
+
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QHash>
 #include <QObject>
+#include <QSharedPointer>
 #include <QStringList>
+class QTimer;
 
 class DictionaryManager : public QObject
 {
@@ -39,28 +46,54 @@ public:
 	QString availableDictionary(const QString& language) const;
 	QString defaultLanguage() const;
 	QStringList personal() const;
+	QStringList personalSuggestions(const QString& word) const;
+	const LanguageDetector* languageDetector() const;
+	QHash<QString, DictionaryRef> residentDictionaries();
+	DictionaryRef pin(const DictionaryRef& dictionary);
 
 	void add(const QString& word);
 	void addProviders();
+	void remove(const QString& word);
 	DictionaryRef requestDictionary(const QString& language = QString());
 	void setDefaultLanguage(const QString& language);
+	void setDetectLanguage(bool detect);
+	void setEvictionPolicy(int idle_minutes, int budget_megabytes);
 	void setIgnoreNumbers(bool ignore);
 	void setIgnoreUppercase(bool ignore);
 	void setPersonal(const QStringList& words);
 
+	static bool isPending(const DictionaryRef& dictionary);
 	static QString installedPath();
 	static QString path();
 	static void setPath(const QString& path);
 
 signals:
+	// Emitted when documents need to be checked again, such as after the
+	// personal dictionary or the checking options change
 	void changed();
 
+	// Emitted when a dictionary finishes loading in the background, so
+	// that only text checked while it was pending needs checking again
+	void loaded(const QString& language);
+
 private:
 	DictionaryManager();
 	~DictionaryManager();
 
 	void addProvider(AbstractDictionaryProvider* provider);
 	AbstractDictionary** requestDictionaryData(const QString& language);
+	void dictionaryLoaded(const QString& language);
+	void detectorBuilt();
+	void evictIdleDictionaries();
+	qint64 estimatedSize(const QString& language);
+	bool isPlaceholder(AbstractDictionary* dictionary) const;
+	DictionaryRef pinned(AbstractDictionary* dictionary) const;
+	QStringList::iterator findPersonal(const QString& word);
+	void journalPersonal(QChar operation, const QString& word);
+	void writePersonal();
+
+	static AbstractDictionary* loadDictionary(const QList<AbstractDictionaryProvider*>& providers,
+			const QString& language, const QStringList& personal);
 
 private:
 	QList<AbstractDictionaryProvider*> m_providers;
@@ -69,6 +102,31 @@ private:
 
 	QString m_default_language;
 	QStringList m_personal;
+	mutable BKTree m_personal_index;
+	int m_journal_entries;
+
+	// Dictionaries being loaded in the background, along with the personal
+	// dictionary that was added to their session.
+	QHash<QString, QFutureWatcher<AbstractDictionary*>*> m_loading;
+	QHash<QString, QStringList> m_loading_personal;
+
+	// Identifies the language of each paragraph, if enabled.
+	LanguageDetector* m_detector;
+	QFutureWatcher<LanguageDetector*>* m_detector_watcher;
+	bool m_detect_language;
+
+	// Loaded dictionaries, shared with the pinned references used by
+	// background spell checks, so that they outlive their eviction.
+	QHash<AbstractDictionary*, QSharedPointer<AbstractDictionary> > m_owned;
+
+	// Dictionaries other than the default are evicted when unused for a
+	// while, once their estimated memory use exceeds the budget.
+	QElapsedTimer m_clock;
+	QTimer* m_eviction_timer;
+	QHash<QString, qint64> m_last_used;
+	QHash<QString, qint64> m_sizes;
+	qint64 m_idle_timeout;
+	qint64 m_memory_budget;
 
 	static QString m_path;
 };
@@ -22,11 +22,15 @@
 
 #include "abstract_dictionary.h"
 #include "dictionary_manager.h"
+#include "verdict_cache.h"
+#include "wordsegmenter.h"
 
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QListIterator>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRegExp>
 #include <QStringList>
 #include <QTextCodec>
@@ -42,6 +46,10 @@
 static bool f_ignore_numbers = false;
 static bool f_ignore_uppercase = true;
 
+// Only dashes, periods, and single quotation marks can be used inside a
+// single word.
+static const ghostwriter::WordSegmenter f_segmenter("-.'", true);
+
 //-----------------------------------------------------------------------------
 
 namespace
@@ -65,9 +73,19 @@ public:
 	void addToSession(const QStringList& words);
 	void removeFromSession(const QStringList& words);
 
+	const VerdictCache* verdictCache() const
+	{
+		return &m_cache;
+	}
+
 private:
 	Hunspell* m_dictionary;
 	QTextCodec* m_codec;
+	mutable VerdictCache m_cache;
+
+	// Hunspell is not thread-safe, and live spell checking is done in a
+	// background thread.
+	mutable QMutex m_mutex;
 };
 
 //-----------------------------------------------------------------------------
@@ -116,127 +134,37 @@ DictionaryHunspell::~DictionaryHunspell()
 
 QStringRef DictionaryHunspell::check(const QString& string, int start_at) const
 {
-    // Incorporated ghostwriter's word splitting algorithm into the original
-    // FocusWriter algorithm to ensure hyphenated words are counted as one
-    // word.
-
-    bool inWord = false;
-    int separatorCount = 0;
-    int wordLen = 0;
-    bool isNumber = false;
-    bool isUppercase = f_ignore_uppercase;
-    bool isWord = false;
-    int index = -1;
-
-    for (int i = start_at; i < string.length(); i++)
-    {
-        QChar c = string.at(i);
-
-        if (c.isLetterOrNumber() || c.isMark())
-        {
-            inWord = true;
-            separatorCount = 0;
-            wordLen++;
-
-            if (index < 0)
-            {
-                index = i;
-            }
-
-            if (c.isNumber())
-            {
-                isNumber = f_ignore_numbers;
-            }
-            else if (c.isLower())
-            {
-                isUppercase = false;
-            }
-        }
-        else if (c.isSpace() && inWord)
-        {
-            inWord = false;
-            isWord = true;
-
-            if (separatorCount > 0)
-            {
-                wordLen--;
-            }
-        }
-        else
-        {
-            // This is to handle things like double dashes (`--`)
-            // that separate words, while still counting hyphenated
-            // words as a single word.
-            //
-            separatorCount++;
-
-            if (inWord)
-            {
-                // Only count dashes (`-`), periods (`.`) and single
-                // quotation marks (`'`) as separators that can be
-                // used inside a single word.
-                //
-                if
-                (
-                    (1 == separatorCount) &&
-                    (QChar('-') != c) &&
-                    (QChar('.') != c) &&
-                    (QChar('\'') != c)
-                )
-                {
-                    separatorCount = 0;
-                    inWord = false;
-                    isWord = true;
-                }
-                else if (separatorCount > 1)
-                {
-                    separatorCount = 0;
-                    inWord = false;
-                    isWord = true;
-                    wordLen--;
-                }
-                else
-                {
-                    wordLen++;
-                }
-            }
-        }
-
-        if (inWord && ((string.length() - 1) == i))
-        {
-            isWord = true;
-
-            if (separatorCount > 0)
-            {
-                wordLen--;
-            }
-        }
-
-        if (isWord && (index >= 0))
-        {
-            if (!isUppercase && !isNumber)
-            {
-                QStringRef check(&string, index, wordLen);
-                QString word = check.toString();
-
-                // Replace any fancy single quotes with a "normal" single quote.
-                word.replace(QChar(0x2019), QLatin1Char('\''));
-
-                if (!m_dictionary->spell(m_codec->fromUnicode(word).constData()))
-                {
-                    return check;
-                }
-            }
-
-            index = -1;
-            wordLen = 0;
-            separatorCount = 0;
-            isWord = false;
-            inWord = false;
-            isNumber = false;
-            isUppercase = f_ignore_uppercase;
-        }
-    }
+	// Words are split the same way that ghostwriter counts them, so that
+	// hyphenated words are checked as one word.
+	ghostwriter::WordSegmenter::WordSpan span;
+	int position = start_at;
+
+	while (f_segmenter.nextWord(string, position, span)) {
+		if ((f_ignore_uppercase && !span.hasLowercase) || (f_ignore_numbers && span.hasNumber)) {
+			continue;
+		}
+
+		QStringRef check(&string, span.position, span.length);
+		QString word = check.toString();
+
+		// Replace any fancy single quotes with a "normal" single quote.
+		word.replace(QChar(0x2019), QLatin1Char('\''));
+
+		VerdictCache::Verdict verdict = m_cache.lookup(word);
+		if (VerdictCache::Unknown == verdict) {
+			QMutexLocker locker(&m_mutex);
+			bool correct = m_dictionary->spell(m_codec->fromUnicode(word).constData());
+
+			// Insert while still locked, so that a concurrent change
+			// to the word list cannot be overwritten by a stale verdict.
+			m_cache.insert(word, correct);
+			verdict = correct ? VerdictCache::Correct : VerdictCache::Misspelled;
+		}
+
+		if (VerdictCache::Misspelled == verdict) {
+			return check;
+		}
+	}
 
 	return QStringRef();
 }
@@ -251,6 +179,11 @@ QStringList DictionaryHunspell::suggestions(const QString& word) const
     // Replace any fancy single quotes with a "normal" single quote.
 	check.replace(QChar(0x2019), QLatin1Char('\''));
 
+	if (m_cache.lookupSuggestions(check, &result)) {
+		return result;
+	}
+
+	QMutexLocker locker(&m_mutex);
 	char** suggestions = 0;
 	int count = m_dictionary->suggest(&suggestions, m_codec->fromUnicode(check).constData());
 	if (suggestions != 0) {
@@ -260,6 +193,7 @@ QStringList DictionaryHunspell::suggestions(const QString& word) const
 		}
 		m_dictionary->free_list(&suggestions, count);
 	}
+	m_cache.insertSuggestions(check, result);
 	return result;
 }
 
@@ -278,6 +212,7 @@ void DictionaryHunspell::addToPersonal(const QString& word)
 
 void DictionaryHunspell::addToSession(const QStringList& words)
 {
+	QMutexLocker locker(&m_mutex);
 	foreach (const QString& word, words) {
 #ifdef _WIN32
 		m_dictionary->add(m_codec->fromUnicode(word).constData());
@@ -285,12 +220,14 @@ void DictionaryHunspell::addToSession(const QStringList& words)
 		m_dictionary->add(m_codec->fromUnicode(word).toStdString());
 #endif
 	}
+	m_cache.clear();
 }
 
 //-----------------------------------------------------------------------------
 
 void DictionaryHunspell::removeFromSession(const QStringList& words)
 {
+	QMutexLocker locker(&m_mutex);
 	foreach (const QString& word, words) {
 #ifdef _WIN32
 		m_dictionary->remove(m_codec->fromUnicode(word).constData());
@@ -299,6 +236,7 @@ void DictionaryHunspell::removeFromSession(const QStringList& words)
 #endif
 
 	}
+	m_cache.clear();
 }
 
 }
@@ -22,6 +22,8 @@
 #include "abstract_dictionary.h"
 #include "dictionary_manager.h"
 
+#include <QMutex>
+#include <QMutexLocker>
 #include <QStringList>
 #include <QVector>
 
@@ -32,6 +34,12 @@
 
 //-----------------------------------------------------------------------------
 
+// Live spell checking is done in a background thread, so serialize access
+// to the shared spell checker.
+static QMutex f_spellchecker_mutex;
+
+//-----------------------------------------------------------------------------
+
 static NSArray* convertList(const QStringList& words)
 {
 	QVector<NSString*> strings;
@@ -102,6 +110,7 @@ QStringRef DictionaryNSSpellChecker::check(const QString& string, int start_at)
 	NSString* nsstring = [NSString stringWithCharacters:reinterpret_cast<const unichar*>(string.unicode()) length:string.length()];
 
 	QStringRef misspelled;
+	QMutexLocker locker(&f_spellchecker_mutex);
 
 	NSRange range = [[NSSpellChecker sharedSpellChecker] checkSpellingOfString:nsstring
 		startingAt:start_at
@@ -131,6 +140,7 @@ QStringList DictionaryNSSpellChecker::suggestions(const QString& word) const
 
 	NSString* nsstring = [NSString stringWithCharacters:reinterpret_cast<const unichar*>(word.unicode()) length:word.length()];
 
+	QMutexLocker locker(&f_spellchecker_mutex);
 	NSArray* array;
         array = [[NSSpellChecker sharedSpellChecker] guessesForWordRange:range
             inString:nsstring
@@ -163,6 +173,7 @@ void DictionaryNSSpellChecker::addToSession(const QStringList& words)
 {
 	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
 
+	QMutexLocker locker(&f_spellchecker_mutex);
 	[[NSSpellChecker sharedSpellChecker] setIgnoredWords:convertList(words) inSpellDocumentWithTag:m_tag];
 
 	[pool release];
@@ -174,6 +185,7 @@ void DictionaryNSSpellChecker::removeFromSession(const QStringList& words)
 {
 	NSAutoreleasePool* pool = [[NSAutoreleasePool alloc] init];
 
+	QMutexLocker locker(&f_spellchecker_mutex);
 	QStringList session;
 	NSArray* array = [[NSSpellChecker sharedSpellChecker] ignoredWordsInSpellDocumentWithTag:m_tag];
 	if (array) {
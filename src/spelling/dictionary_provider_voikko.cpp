@@ -22,11 +22,15 @@
 
 #include "abstract_dictionary.h"
 #include "dictionary_manager.h"
+#include "verdict_cache.h"
 
+#include <QAtomicInt>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QLibrary>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QStringList>
 #include <QStringRef>
 
@@ -64,6 +68,14 @@ namespace
 	bool f_voikko_loaded = false;
 	QList<VoikkoHandle*> f_handles;
 	QByteArray f_voikko_path;
+
+	// Voikko handles must not be used concurrently, and live spell
+	// checking is done in a background thread.
+	QMutex f_voikko_mutex;
+
+	// Incremented whenever voikko options change, since cached spelling
+	// verdicts depend on them.
+	QAtomicInt f_voikko_options_generation;
 }
 
 //-----------------------------------------------------------------------------
@@ -94,15 +106,27 @@ public:
 	void addToSession(const QStringList& words);
 	void removeFromSession(const QStringList& words);
 
+	const VerdictCache* verdictCache() const
+	{
+		return &m_cache;
+	}
+
+private:
+	void validateCache() const;
+
 private:
 	VoikkoHandle* m_handle;
+	mutable VerdictCache m_cache;
+	mutable QAtomicInt m_cache_generation;
 };
 
 //-----------------------------------------------------------------------------
 
 DictionaryVoikko::DictionaryVoikko(const QString& language) :
-	m_handle(0)
+	m_handle(0),
+	m_cache_generation(0)
 {
+	QMutexLocker locker(&f_voikko_mutex);
 	const char* voikko_error;
 	m_handle = voikkoInit(&voikko_error, language.toUtf8().constData(), f_voikko_path.constData());
 	if (voikko_error) {
@@ -111,6 +135,7 @@ DictionaryVoikko::DictionaryVoikko(const QString& language) :
 		voikkoSetBooleanOption(m_handle, VOIKKO_OPT_IGNORE_NUMBERS, f_ignore_numbers);
 		voikkoSetBooleanOption(m_handle, VOIKKO_OPT_IGNORE_UPPERCASE, f_ignore_uppercase);
 		f_handles.append(m_handle);
+		m_cache_generation.store(f_voikko_options_generation.load());
 	}
 }
 
@@ -119,6 +144,7 @@ DictionaryVoikko::DictionaryVoikko(const QString& language) :
 DictionaryVoikko::~DictionaryVoikko()
 {
 	if (m_handle) {
+		QMutexLocker locker(&f_voikko_mutex);
 		f_handles.removeAll(m_handle);
 		voikkoTerminate(m_handle);
 	}
@@ -154,7 +180,17 @@ QStringRef DictionaryVoikko::check(const QString& string, int start_at) const
 
 		if (is_word || (i == count && index != -1)) {
 			QStringRef check(&string, index, length);
-			if (voikkoSpellCstr(m_handle, check.toString().toUtf8().constData()) != VOIKKO_SPELL_OK) {
+			QString word = check.toString();
+			validateCache();
+			VerdictCache::Verdict verdict = m_cache.lookup(word);
+			if (verdict == VerdictCache::Unknown) {
+				QMutexLocker locker(&f_voikko_mutex);
+				validateCache();
+				bool correct = voikkoSpellCstr(m_handle, word.toUtf8().constData()) == VOIKKO_SPELL_OK;
+				m_cache.insert(word, correct);
+				verdict = correct ? VerdictCache::Correct : VerdictCache::Misspelled;
+			}
+			if (verdict == VerdictCache::Misspelled) {
 				return check;
 			}
 			index = -1;
@@ -167,9 +203,27 @@ QStringRef DictionaryVoikko::check(const QString& string, int start_at) const
 
 //-----------------------------------------------------------------------------
 
+void DictionaryVoikko::validateCache() const
+{
+	int generation = f_voikko_options_generation.load();
+	if (m_cache_generation.load() != generation) {
+		m_cache.clear();
+		m_cache_generation.store(generation);
+	}
+}
+
+//-----------------------------------------------------------------------------
+
 QStringList DictionaryVoikko::suggestions(const QString& word) const
 {
 	QStringList result;
+	validateCache();
+	if (m_cache.lookupSuggestions(word, &result)) {
+		return result;
+	}
+
+	QMutexLocker locker(&f_voikko_mutex);
+	validateCache();
 	char** suggestions = voikkoSuggestCstr(m_handle, word.toUtf8().constData());
 	if (suggestions) {
 		for (size_t i = 0; suggestions[i] != NULL; ++i) {
@@ -178,6 +232,7 @@ QStringList DictionaryVoikko::suggestions(const QString& word) const
 		}
 		voikkoFreeCstrArray(suggestions);
 	}
+	m_cache.insertSuggestions(word, result);
 	return result;
 }
 
@@ -297,6 +352,8 @@ AbstractDictionary* DictionaryProviderVoikko::requestDictionary(const QString& l
 void DictionaryProviderVoikko::setIgnoreNumbers(bool ignore)
 {
 	f_ignore_numbers = ignore;
+	QMutexLocker locker(&f_voikko_mutex);
+	f_voikko_options_generation.ref();
 	foreach (VoikkoHandle* handle, f_handles) {
 		voikkoSetBooleanOption(handle, VOIKKO_OPT_IGNORE_NUMBERS, ignore);
 	}
@@ -307,6 +364,8 @@ void DictionaryProviderVoikko::setIgnoreNumbers(bool ignore)
 void DictionaryProviderVoikko::setIgnoreUppercase(bool ignore)
 {
 	f_ignore_uppercase = ignore;
+	QMutexLocker locker(&f_voikko_mutex);
+	f_voikko_options_generation.ref();
 	foreach (VoikkoHandle* handle, f_handles) {
 		voikkoSetBooleanOption(handle, VOIKKO_OPT_IGNORE_UPPERCASE, ignore);
 	}
@@ -23,6 +23,7 @@
 #include "abstract_dictionary.h"
 class DictionaryManager;
 
+#include <QSharedPointer>
 #include <QStringList>
 #include <QStringRef>
 
@@ -31,17 +32,17 @@ class DictionaryRef
 public:
 	QStringRef check(const QString& string, int start_at) const
 	{
-		return (*d)->check(string, start_at);
+		return dictionary()->check(string, start_at);
 	}
 
 	QStringList suggestions(const QString& word) const
 	{
-		return (*d)->suggestions(word);
+		return dictionary()->suggestions(word);
 	}
 
 	void addToPersonal(const QString& word)
 	{
-		(*d)->addToPersonal(word);
+		dictionary()->addToPersonal(word);
 	}
 
 	friend class DictionaryManager;
@@ -53,8 +54,23 @@ private:
 		Q_ASSERT(d != 0);
 	}
 
+	// A pinned reference keeps using the dictionary it was created with,
+	// and keeps it alive, even if another one takes its slot
+	DictionaryRef(const QSharedPointer<AbstractDictionary>& pinned) :
+		d(0),
+		m_pinned(pinned)
+	{
+		Q_ASSERT(!m_pinned.isNull());
+	}
+
+	AbstractDictionary* dictionary() const
+	{
+		return m_pinned.isNull() ? *d : m_pinned.data();
+	}
+
 private:
 	AbstractDictionary** d;
+	QSharedPointer<AbstractDictionary> m_pinned;
 };
 
 #endif
@@ -0,0 +1,197 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#include "language_detector.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QPair>
+#include <QTextCodec>
+#include <QTextStream>
+#include <QVector>
+
+#include <algorithm>
+#include <climits>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+	// Number of most frequent trigrams kept for each language
+	const int PROFILE_SIZE = 300;
+
+	// Number of words read from each dictionary's word list
+	const int MAX_PROFILE_WORDS = 50000;
+
+	// Passages with fewer trigrams than this are too short to identify
+	const int MIN_TRIGRAMS = 20;
+
+	QTextCodec* dictionaryCodec(const QString& language)
+	{
+		QFile file(QFileInfo("dict:" + language + ".aff").canonicalFilePath());
+		if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+			while (!file.atEnd()) {
+				QByteArray line = file.readLine().trimmed();
+				if (line.startsWith("SET ")) {
+					QTextCodec* codec = QTextCodec::codecForName(line.mid(4).trimmed());
+					if (codec) {
+						return codec;
+					}
+					break;
+				}
+			}
+		}
+		return QTextCodec::codecForName("ISO-8859-1");
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+LanguageDetector::LanguageDetector()
+{
+}
+
+//-----------------------------------------------------------------------------
+
+LanguageDetector* LanguageDetector::build(const QStringList& languages)
+{
+	LanguageDetector* detector = new LanguageDetector;
+
+	// Regional variants of a language can't be told apart by trigrams, so
+	// only profile one dictionary for each language
+	QStringList profiled;
+	foreach (const QString& language, languages) {
+		QString base = language.section(QLatin1Char('_'), 0, 0);
+		if (profiled.contains(base)) {
+			continue;
+		}
+
+		QFile file(QFileInfo("dict:" + language + ".dic").canonicalFilePath());
+		if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+			continue;
+		}
+
+		QTextStream stream(&file);
+		stream.setCodec(dictionaryCodec(language));
+
+		// First line of the word list is the word count
+		stream.readLine();
+
+		QHash<QString, int> counts;
+		for (int i = 0; (i < MAX_PROFILE_WORDS) && !stream.atEnd(); ++i) {
+			QString word = stream.readLine().section(QLatin1Char('/'), 0, 0);
+			countTrigrams(word, counts);
+		}
+
+		if (!counts.isEmpty()) {
+			detector->m_profiles.insert(language, buildProfile(counts));
+			profiled.append(base);
+		}
+	}
+
+	return detector;
+}
+
+//-----------------------------------------------------------------------------
+
+QString LanguageDetector::detect(const QString& text) const
+{
+	if (m_profiles.size() < 2) {
+		return QString();
+	}
+
+	QHash<QString, int> counts;
+	countTrigrams(text, counts);
+
+	int total = 0;
+	foreach (int count, counts) {
+		total += count;
+	}
+	if (total < MIN_TRIGRAMS) {
+		return QString();
+	}
+
+	// Find the language whose profile is the least out of place
+	Profile profile = buildProfile(counts);
+	QString best;
+	int best_distance = INT_MAX;
+	for (QHash<QString, Profile>::const_iterator i = m_profiles.constBegin(); i != m_profiles.constEnd(); ++i) {
+		int distance = 0;
+		for (Profile::const_iterator j = profile.constBegin(); j != profile.constEnd(); ++j) {
+			Profile::const_iterator rank = i.value().constFind(j.key());
+			distance += (rank != i.value().constEnd()) ? qAbs(rank.value() - j.value()) : PROFILE_SIZE;
+		}
+		if (distance < best_distance) {
+			best_distance = distance;
+			best = i.key();
+		}
+	}
+	return best;
+}
+
+//-----------------------------------------------------------------------------
+
+LanguageDetector::Profile LanguageDetector::buildProfile(const QHash<QString, int>& counts)
+{
+	QVector<QPair<int, QString> > ranked;
+	ranked.reserve(counts.size());
+	for (QHash<QString, int>::const_iterator i = counts.constBegin(); i != counts.constEnd(); ++i) {
+		ranked.append(qMakePair(-i.value(), i.key()));
+	}
+	int size = qMin(PROFILE_SIZE, ranked.size());
+	std::partial_sort(ranked.begin(), ranked.begin() + size, ranked.end());
+
+	Profile profile;
+	for (int i = 0; i < size; ++i) {
+		profile.insert(ranked.at(i).second, i);
+	}
+	return profile;
+}
+
+//-----------------------------------------------------------------------------
+
+void LanguageDetector::countTrigrams(const QString& text, QHash<QString, int>& counts)
+{
+	// Words are padded with a space on each side, so that trigrams at
+	// word boundaries are counted as well.  Only trigrams centered on a
+	// letter are counted.
+	QString trigram(3, QLatin1Char(' '));
+	bool in_word = false;
+	for (int i = 0; i <= text.length(); ++i) {
+		QChar c = (i < text.length()) ? text.at(i).toLower() : QChar(' ');
+		if (c.isLetter()) {
+			in_word = true;
+		} else if (in_word) {
+			c = QLatin1Char(' ');
+			in_word = false;
+		} else {
+			continue;
+		}
+
+		trigram[0] = trigram.at(1);
+		trigram[1] = trigram.at(2);
+		trigram[2] = c;
+		if (trigram.at(1).isLetter()) {
+			counts[trigram]++;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
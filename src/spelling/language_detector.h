@@ -0,0 +1,58 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef LANGUAGE_DETECTOR_H
+#define LANGUAGE_DETECTOR_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Identifies the language of a passage of text by comparing the frequency
+ * ranks of its letter trigrams against a profile built for each installed
+ * Hunspell dictionary.  Building the profiles reads the word lists from
+ * disk, so it should be done in the background; detection is read-only
+ * and can be done from any thread once built.
+ */
+class LanguageDetector
+{
+public:
+	static LanguageDetector* build(const QStringList& languages);
+
+	QString detect(const QString& text) const;
+
+	QStringList languages() const
+	{
+		return m_profiles.keys();
+	}
+
+private:
+	LanguageDetector();
+
+	typedef QHash<QString, int> Profile;
+	static Profile buildProfile(const QHash<QString, int>& counts);
+	static void countTrigrams(const QString& text, QHash<QString, int>& counts);
+
+private:
+	QHash<QString, Profile> m_profiles;
+};
+
+#endif
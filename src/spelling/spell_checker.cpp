@@ -20,9 +20,12 @@
 
 #include "spell_checker.h"
 
+#include "dictionary_manager.h"
 #include "dictionary_ref.h"
+#include "textblockdata.h"
 
 #include <QAction>
+#include <QtConcurrentMap>
 #include <QDialogButtonBox>
 #include <QDir>
 #include <QFileInfo>
@@ -40,6 +43,61 @@
 
 //-----------------------------------------------------------------------------
 
+struct SpellCheckScanResult
+{
+	int number;
+	int revision;
+	QVector<int> positions;
+	QVector<int> lengths;
+};
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+
+struct BlockSnapshot
+{
+	int number;
+	int revision;
+	QString text;
+};
+
+// Finds all misspelled words within a snapshot of a text block.  This is
+// run in parallel for the blocks of the document on the global thread pool.
+class ScanBlock
+{
+public:
+	typedef SpellCheckScanResult result_type;
+
+	ScanBlock(const DictionaryRef& dictionary) :
+		m_dictionary(dictionary)
+	{
+	}
+
+	SpellCheckScanResult operator()(const BlockSnapshot& snapshot) const
+	{
+		SpellCheckScanResult result;
+		result.number = snapshot.number;
+		result.revision = snapshot.revision;
+
+		QStringRef word = m_dictionary.check(snapshot.text, 0);
+		while (!word.isNull()) {
+			result.positions.append(word.position());
+			result.lengths.append(word.length());
+			word = m_dictionary.check(snapshot.text, word.position() + word.length());
+		}
+		return result;
+	}
+
+private:
+	DictionaryRef m_dictionary;
+};
+
+}
+
+//-----------------------------------------------------------------------------
+
 void SpellChecker::checkDocument(QPlainTextEdit* document, QSyntaxHighlighter* spelling_highlighter, DictionaryRef& dictionary)
 {
     SpellChecker* checker = new SpellChecker(document, spelling_highlighter, dictionary);
@@ -47,6 +105,7 @@ void SpellChecker::checkDocument(QPlainTextEdit* document, QSyntaxHighlighter* s
 	checker->m_cursor = checker->m_start_cursor;
 	checker->m_cursor.movePosition(QTextCursor::StartOfBlock);
 	checker->m_loop_available = checker->m_start_cursor.block().previous().isValid();
+	checker->startScan();
 	checker->show();
     checker->check();
 }
@@ -93,6 +152,7 @@ void SpellChecker::ignore()
 
 void SpellChecker::ignoreAll()
 {
+	// Remaining occurrences found by the scan are skipped as they come up.
 	m_ignored.append(m_word);
 	ignore();
 }
@@ -111,6 +171,8 @@ void SpellChecker::changeAll()
 {
 	QString replacement = m_suggestion->text();
 
+	// Occurrences found by the scan track the edits, and are skipped as
+	// they come up since they no longer select the misspelled word.
 	QTextCursor cursor = m_cursor;
 	cursor.movePosition(QTextCursor::Start);
 	forever {
@@ -134,7 +196,8 @@ SpellChecker::SpellChecker(QPlainTextEdit* document, QSyntaxHighlighter* spellin
     m_spelling_highlighter(spelling_highlighter),
 	m_checked_blocks(1),
 	m_total_blocks(document->document()->blockCount()),
-	m_loop_available(true)
+	m_loop_available(true),
+	m_scan(0)
 {
 	setWindowTitle(tr("Check Spelling"));
 	setWindowModality(Qt::WindowModal);
@@ -197,6 +260,115 @@ SpellChecker::SpellChecker(QPlainTextEdit* document, QSyntaxHighlighter* spellin
 
 //-----------------------------------------------------------------------------
 
+SpellChecker::~SpellChecker()
+{
+	if (m_scan) {
+		m_scan->cancel();
+		m_scan->waitForFinished();
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+void SpellChecker::startScan()
+{
+	QTextDocument* document = m_document->document();
+	int count = document->blockCount();
+	m_misspellings.resize(count);
+	m_scanned.fill(false, count);
+
+	// Snapshot the blocks in the order they will be visited, starting
+	// with the block at the cursor and wrapping around to the beginning,
+	// so that the first results are the first needed.
+	QVector<BlockSnapshot> snapshots;
+	snapshots.reserve(count);
+	QTextBlock start = m_cursor.block();
+	QTextBlock block = start;
+	do {
+		BlockSnapshot snapshot;
+		snapshot.number = block.blockNumber();
+		snapshot.revision = block.revision();
+		snapshot.text = ghostwriter::TextBlockData::proseText(block);
+		snapshots.append(snapshot);
+
+		block = block.next();
+		if (!block.isValid()) {
+			block = document->begin();
+		}
+	} while (block != start);
+
+	m_scan = new QFutureWatcher<SpellCheckScanResult>(this);
+	connect(m_scan, SIGNAL(resultsReadyAt(int, int)), this, SLOT(scanResultsReady(int, int)));
+	m_scan->setFuture(QtConcurrent::mapped(snapshots, ScanBlock(DictionaryManager::instance().pin(m_dictionary))));
+}
+
+//-----------------------------------------------------------------------------
+
+void SpellChecker::scanResultsReady(int begin, int end)
+{
+	QTextDocument* document = m_document->document();
+
+	for (int i = begin; i < end; ++i) {
+		SpellCheckScanResult result = m_scan->resultAt(i);
+		QTextBlock block = document->findBlockByNumber(result.number);
+
+		// Blocks that were edited since the snapshot are checked when
+		// they are reached instead.
+		if (!block.isValid() || (block.revision() != result.revision) || (result.number >= m_scanned.size())) {
+			continue;
+		}
+
+		QList<QPair<QTextCursor, QString> > misspellings;
+		for (int j = 0; j < result.positions.size(); ++j) {
+			QTextCursor cursor(block);
+			cursor.setPosition(block.position() + result.positions.at(j));
+			cursor.setPosition(cursor.position() + result.lengths.at(j), QTextCursor::KeepAnchor);
+			misspellings.append(qMakePair(cursor, cursor.selectedText()));
+		}
+		m_misspellings[result.number] = misspellings;
+		m_scanned[result.number] = true;
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+QTextCursor SpellChecker::findMisspelling(const QTextBlock& block, int position) const
+{
+	int number = block.blockNumber();
+
+	if ((number < m_scanned.size()) && m_scanned.at(number)) {
+		typedef QPair<QTextCursor, QString> Misspelling;
+		foreach (const Misspelling& misspelling, m_misspellings.at(number)) {
+			const QTextCursor& cursor = misspelling.first;
+			if (cursor.selectionStart() < position) {
+				continue;
+			}
+
+			// Skip words that have since been changed, or that have been
+			// added to the dictionary.
+			if ((cursor.selectedText() != misspelling.second)
+					|| m_dictionary.check(misspelling.second, 0).isNull()) {
+				continue;
+			}
+			return cursor;
+		}
+		return QTextCursor();
+	}
+
+	// Block has not been scanned yet, so check it now.
+	QString text = ghostwriter::TextBlockData::proseText(block);
+	QStringRef word = m_dictionary.check(text, position - block.position());
+	if (word.isNull()) {
+		return QTextCursor();
+	}
+	QTextCursor cursor(block);
+	cursor.setPosition(block.position() + word.position());
+	cursor.setPosition(cursor.position() + word.length(), QTextCursor::KeepAnchor);
+	return cursor;
+}
+
+//-----------------------------------------------------------------------------
+
 void SpellChecker::check()
 {
 	setDisabled(true);
@@ -216,8 +388,11 @@ void SpellChecker::check()
 		}
 
 		// Check current line
+		// Find the next misspelled word in the current line.  Note that only
+		// the prose is checked, skipping over code, HTML, URLs, and other
+		// markup.
 		QTextBlock block = m_cursor.block();
-		QStringRef word =  m_dictionary.check(block.text(), m_cursor.position() - block.position());
+		QTextCursor word = findMisspelling(block, m_cursor.position());
 		if (word.isNull()) {
 			if (block.next().isValid()) {
                 m_cursor.movePosition(QTextCursor::NextBlock);
@@ -245,8 +420,8 @@ void SpellChecker::check()
 		}
 
 		// Select misspelled word
-		m_cursor.setPosition(word.position() + block.position());
-		m_cursor.setPosition(m_cursor.position() + word.length(), QTextCursor::KeepAnchor);
+		m_cursor.setPosition(word.selectionStart());
+		m_cursor.setPosition(word.selectionEnd(), QTextCursor::KeepAnchor);
 		m_word = m_cursor.selectedText();
 
 		if (!m_ignored.contains(m_word)) {
@@ -22,9 +22,14 @@
 #define SPELL_H
 
 class DictionaryRef;
+struct SpellCheckScanResult;
 
 #include <QDialog>
+#include <QFutureWatcher>
+#include <QList>
+#include <QPair>
 #include <QTextCursor>
+#include <QVector>
 class QAction;
 class QLineEdit;
 class QListWidget;
@@ -50,10 +55,14 @@ private slots:
 	void ignoreAll();
 	void change();
 	void changeAll();
+	void scanResultsReady(int begin, int end);
 
 private:
     SpellChecker(QPlainTextEdit* document, QSyntaxHighlighter* spelling_highlighter, DictionaryRef& dictionary);
+	~SpellChecker();
 	void check();
+	void startScan();
+	QTextCursor findMisspelling(const QTextBlock& block, int position) const;
 
 private:
 	DictionaryRef& m_dictionary;
@@ -72,6 +81,12 @@ private:
 
 	QString m_word;
 	QStringList m_ignored;
+
+	// Misspelled words found by the background scan of the document,
+	// indexed by block number, in the order they appear in each block.
+	QFutureWatcher<SpellCheckScanResult>* m_scan;
+	QVector<QList<QPair<QTextCursor, QString> > > m_misspellings;
+	QVector<bool> m_scanned;
 };
 
 #endif
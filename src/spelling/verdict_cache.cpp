@@ -0,0 +1,127 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#include "verdict_cache.h"
+
+#include <QReadLocker>
+#include <QWriteLocker>
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+	// Upper bound on the number of cached words, to keep memory use in check
+	// for very long documents.  Typical prose stays well below this limit.
+	const int MAX_CACHED_WORDS = 100000;
+
+	// Suggestions are only looked up for words the user asks about, so far
+	// fewer of them are needed.
+	const int MAX_CACHED_SUGGESTIONS = 1000;
+}
+
+//-----------------------------------------------------------------------------
+
+VerdictCache::VerdictCache() :
+	m_hits(0),
+	m_misses(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+
+VerdictCache::Verdict VerdictCache::lookup(const QString& word) const
+{
+	QReadLocker locker(&m_lock);
+	QHash<QString, bool>::const_iterator i = m_verdicts.constFind(word);
+	if (i == m_verdicts.constEnd()) {
+		m_misses.ref();
+		return Unknown;
+	}
+	m_hits.ref();
+	return i.value() ? Correct : Misspelled;
+}
+
+//-----------------------------------------------------------------------------
+
+void VerdictCache::insert(const QString& word, bool correct)
+{
+	QWriteLocker locker(&m_lock);
+	if (m_verdicts.size() >= MAX_CACHED_WORDS) {
+		m_verdicts.clear();
+	}
+	m_verdicts.insert(word, correct);
+}
+
+//-----------------------------------------------------------------------------
+
+bool VerdictCache::lookupSuggestions(const QString& word, QStringList* suggestions) const
+{
+	QReadLocker locker(&m_lock);
+	QHash<QString, QStringList>::const_iterator i = m_suggestions.constFind(word);
+	if (i == m_suggestions.constEnd()) {
+		return false;
+	}
+	*suggestions = i.value();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void VerdictCache::insertSuggestions(const QString& word, const QStringList& suggestions)
+{
+	QWriteLocker locker(&m_lock);
+	if (m_suggestions.size() >= MAX_CACHED_SUGGESTIONS) {
+		m_suggestions.clear();
+	}
+	m_suggestions.insert(word, suggestions);
+}
+
+//-----------------------------------------------------------------------------
+
+void VerdictCache::clear()
+{
+	QWriteLocker locker(&m_lock);
+	m_verdicts.clear();
+	m_suggestions.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+int VerdictCache::hits() const
+{
+	return m_hits.load();
+}
+
+//-----------------------------------------------------------------------------
+
+int VerdictCache::misses() const
+{
+	return m_misses.load();
+}
+
+//-----------------------------------------------------------------------------
+
+qreal VerdictCache::hitRate() const
+{
+	int hits = m_hits.load();
+	int total = hits + m_misses.load();
+	return (total > 0) ? (qreal(hits) / total) : 0.0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,65 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+#ifndef VERDICT_CACHE_H
+#define VERDICT_CACHE_H
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Thread-safe cache of spelling verdicts (correct or misspelled) for
+ * individual words, along with the spelling suggestions found for them,
+ * for use by dictionaries whose lookups are expensive.  The cache must be
+ * cleared whenever the dictionary's word list changes.
+ */
+class VerdictCache
+{
+public:
+	enum Verdict
+	{
+		Unknown,
+		Correct,
+		Misspelled
+	};
+
+	VerdictCache();
+
+	Verdict lookup(const QString& word) const;
+	void insert(const QString& word, bool correct);
+	bool lookupSuggestions(const QString& word, QStringList* suggestions) const;
+	void insertSuggestions(const QString& word, const QStringList& suggestions);
+	void clear();
+
+	int hits() const;
+	int misses() const;
+	qreal hitRate() const;
+
+private:
+	mutable QReadWriteLock m_lock;
+	QHash<QString, bool> m_verdicts;
+	QHash<QString, QStringList> m_suggestions;
+	mutable QAtomicInt m_hits;
+	mutable QAtomicInt m_misses;
+};
+
+#endif
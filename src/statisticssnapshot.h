@@ -0,0 +1,108 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef STATISTICS_SNAPSHOT_H
+#define STATISTICS_SNAPSHOT_H
+
+#include <QMetaType>
+
+namespace ghostwriter
+{
+/**
+ * Immutable set of document statistics, published by DocumentStatistics
+ * whenever any of its values change.  The values are those of either the
+ * entire document or the selected text.
+ */
+struct StatisticsSnapshot
+{
+    StatisticsSnapshot()
+        : wordCount(0),
+          totalWordCount(0),
+          characterCount(0),
+          sentenceCount(0),
+          paragraphCount(0),
+          pageCount(0),
+          complexWords(0),
+          readingTime(0),
+          lixReadingEase(0),
+          readabilityIndex(0)
+    {
+        ;
+    }
+
+    bool operator==(const StatisticsSnapshot &other) const
+    {
+        return (wordCount == other.wordCount)
+            && (totalWordCount == other.totalWordCount)
+            && (characterCount == other.characterCount)
+            && (sentenceCount == other.sentenceCount)
+            && (paragraphCount == other.paragraphCount)
+            && (pageCount == other.pageCount)
+            && (complexWords == other.complexWords)
+            && (readingTime == other.readingTime)
+            && (lixReadingEase == other.lixReadingEase)
+            && (readabilityIndex == other.readabilityIndex);
+    }
+
+    bool operator!=(const StatisticsSnapshot &other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * Word count of the entire document or of the selected text.
+     */
+    int wordCount;
+
+    /**
+     * Word count of the entire document, even when text is selected.
+     */
+    int totalWordCount;
+
+    int characterCount;
+    int sentenceCount;
+    int paragraphCount;
+    int pageCount;
+
+    /**
+     * Percentage of words that are complex.
+     */
+    int complexWords;
+
+    /**
+     * Reading time in minutes.
+     */
+    int readingTime;
+
+    /**
+     * LIX reading ease.
+     */
+    int lixReadingEase;
+
+    /**
+     * Coleman-Liau readability index (CLI).
+     */
+    int readabilityIndex;
+};
+} // namespace ghostwriter
+
+Q_DECLARE_METATYPE(ghostwriter::StatisticsSnapshot)
+
+#endif // STATISTICS_SNAPSHOT_H
@@ -20,9 +20,10 @@
 #ifndef TEXTBLOCKDATA_H
 #define TEXTBLOCKDATA_H
 
-#include <QObject>
 #include <QTextBlock>
 #include <QTextBlockUserData>
+#include <QString>
+#include <QVector>
 
 #include "markdowndocument.h"
 
@@ -30,23 +31,51 @@ namespace ghostwriter
 {
 /**
  * User data for use with the MarkdownHighlighter and DocumentStatistics.
+ * This is a plain record rather than a QObject, since every line of the
+ * document has one.
  */
-class TextBlockData : public QObject, public QTextBlockUserData
+class TextBlockData : public QTextBlockUserData
 {
-    Q_OBJECT
-
 public:
+    /**
+     * Misspelled word found by live spell checking, along with its
+     * position within the block text.
+     */
+    struct Misspelling
+    {
+        int position;
+        QString word;
+    };
+
+    /**
+     * Range of characters within the block text.
+     */
+    struct TextRange
+    {
+        int position;
+        int length;
+    };
+
     /**
      * Constructor.
      */
-    TextBlockData(MarkdownDocument *document, const QTextBlock &block)
-        : document(document), blockRef(block)
+    TextBlockData(MarkdownDocument *document)
+        : document(document)
     {
         wordCount = 0;
         alphaNumericCharacterCount = 0;
         sentenceCount = 0;
         lixLongWordCount = 0;
         blankLine = true;
+        proseRangesValid = false;
+        proseKey = 0;
+        proseKeyValid = false;
+        sentenceBoundariesRevision = -1;
+        spellCheckKey = 0;
+        spellCheckGeneration = -1;
+        spellCheckTextLength = 0;
+        pendingSpellCheckKey = 0;
+        pendingSpellCheckGeneration = -1;
     }
 
     /**
@@ -54,9 +83,15 @@ public:
      */
     virtual ~TextBlockData()
     {
-        document->notifyTextBlockRemoved(blockRef);
+        if (nullptr != document) {
+            document->notifyTextBlockRemoved(this);
+        }
     }
 
+    /**
+     * Document to notify when the block is removed.  Null once the
+     * document itself is being destroyed.
+     */
     MarkdownDocument *document;
 
     int wordCount;
@@ -66,10 +101,91 @@ public:
     bool blankLine;
 
     /**
-     * Parent text block.  For use with fetching the block's document
-     * position, which can shift as text is inserted and deleted.
+     * Ranges of the block text that are prose (i.e., Markdown text nodes),
+     * as opposed to markup, code, HTML, or URLs.  Only valid if the
+     * highlighter was able to determine them from the Markdown AST.
+     */
+    QVector<TextRange> proseRanges;
+    bool proseRangesValid;
+
+    /**
+     * Hash of the prose text for which the highlighter last notified
+     * listeners of a change.  See
+     * MarkdownDocument::textBlockProseChanged().
+     */
+    uint proseKey;
+    bool proseKeyValid;
+
+    /**
+     * Sentence boundaries in the block text, as found by the
+     * SentenceSegmenter, along with the revision of the block they were
+     * found for.  See QTextBlock::revision().
+     */
+    QVector<int> sentenceBoundaries;
+    int sentenceBoundariesRevision;
+
+    /**
+     * Results of the last live spell check of this block, along with the
+     * hash of the prose text, dictionary generation, and text length they
+     * were computed for.  The pending fields track a spell check that is
+     * still in progress.
+     */
+    QVector<Misspelling> misspellings;
+    uint spellCheckKey;
+    int spellCheckGeneration;
+    int spellCheckTextLength;
+    uint pendingSpellCheckKey;
+    int pendingSpellCheckGeneration;
+
+    /**
+     * Language of the dictionary the block was last spell checked with,
+     * if detected to be other than the default language.  Empty if the
+     * default dictionary was used.
+     */
+    QString language;
+
+    /**
+     * Returns a copy of the given block text in which all characters
+     * outside of the prose ranges are replaced with spaces, so that
+     * positions of words within the text are preserved.  Returns the
+     * text as is if the prose ranges are not valid.
      */
-    QTextBlock blockRef;
+    QString proseText(const QString &text) const
+    {
+        if (!proseRangesValid) {
+            return text;
+        }
+
+        QString prose(text.length(), QChar(' '));
+
+        foreach (const TextRange &range, proseRanges) {
+            if ((range.position + range.length) <= text.length()) {
+                prose.replace
+                (
+                    range.position,
+                    range.length,
+                    text.constData() + range.position,
+                    range.length
+                );
+            }
+        }
+
+        return prose;
+    }
+
+    /**
+     * Returns the prose text of the given block.  See proseText() above.
+     */
+    static QString proseText(const QTextBlock &block)
+    {
+        TextBlockData *blockData = (TextBlockData *) block.userData();
+
+        if (nullptr == blockData) {
+            return block.text();
+        }
+
+        return blockData->proseText(block.text());
+    }
 };
 } // namespace ghostwriter
 
@@ -0,0 +1,254 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "wordsegmenter.h"
+
+namespace ghostwriter
+{
+namespace
+{
+enum CharacterClass
+{
+    WordCharacter = 0x1,
+    SpaceCharacter = 0x2,
+    LowercaseCharacter = 0x4,
+    NumberCharacter = 0x8
+};
+
+// Classes of the ASCII characters, built from the same QChar properties
+// that are used for all other characters, so that both agree.
+const unsigned char *asciiClasses()
+{
+    static const struct Table
+    {
+        Table()
+        {
+            for (int i = 0; i < 128; i++) {
+                QChar c(i);
+                classes[i] = 0;
+
+                if (c.isLetterOrNumber()) {
+                    classes[i] |= WordCharacter;
+
+                    if (c.isNumber()) {
+                        classes[i] |= NumberCharacter;
+                    } else if (c.isLower()) {
+                        classes[i] |= LowercaseCharacter;
+                    }
+                } else if (c.isSpace()) {
+                    classes[i] |= SpaceCharacter;
+                }
+            }
+        }
+
+        unsigned char classes[128];
+    } table;
+
+    return table.classes;
+}
+
+#ifdef __SSE2__
+// Returns the number of characters (0 or 8) at the given position that are
+// all ASCII letters or digits, along with whether any of them are lowercase
+// letters or digits.  Characters outside of the ASCII range compare as not
+// being letters or digits.
+//
+inline int asciiWordRun(const ushort *chars, bool &hasLowercase, bool &hasNumber)
+{
+    __m128i v = _mm_loadu_si128((const __m128i *) chars);
+    __m128i folded = _mm_or_si128(v, _mm_set1_epi16(0x20));
+
+    __m128i lower =
+        _mm_and_si128
+        (
+            _mm_cmpgt_epi16(v, _mm_set1_epi16('a' - 1)),
+            _mm_cmplt_epi16(v, _mm_set1_epi16('z' + 1))
+        );
+    __m128i letter =
+        _mm_and_si128
+        (
+            _mm_cmpgt_epi16(folded, _mm_set1_epi16('a' - 1)),
+            _mm_cmplt_epi16(folded, _mm_set1_epi16('z' + 1))
+        );
+    __m128i digit =
+        _mm_and_si128
+        (
+            _mm_cmpgt_epi16(v, _mm_set1_epi16('0' - 1)),
+            _mm_cmplt_epi16(v, _mm_set1_epi16('9' + 1))
+        );
+
+    if (0xFFFF != _mm_movemask_epi8(_mm_or_si128(letter, digit))) {
+        return 0;
+    }
+
+    hasLowercase = hasLowercase || (0 != _mm_movemask_epi8(lower));
+    hasNumber = hasNumber || (0 != _mm_movemask_epi8(digit));
+    return 8;
+}
+#endif
+} // namespace
+
+WordSegmenter::WordSegmenter
+(
+    const QString &intraWordSeparators,
+    bool marksInWords
+)
+    : intraWordSeparators(intraWordSeparators),
+      marksInWords(marksInWords)
+{
+    ;
+}
+
+bool WordSegmenter::nextWord(const QString &text, int &position, WordSpan &word) const
+{
+    const unsigned char *classes = asciiClasses();
+    const ushort *chars = text.utf16();
+    int length = text.length();
+    bool inWord = false;
+    int separatorCount = 0;
+
+    word.position = -1;
+    word.length = 0;
+    word.hasLowercase = false;
+    word.hasNumber = false;
+
+    for (int i = position; i < length; i++) {
+        ushort ucs = chars[i];
+        int cls;
+
+        if (ucs < 128) {
+            cls = classes[ucs];
+        } else {
+            QChar c(ucs);
+            cls = 0;
+
+            if (c.isLetterOrNumber() || (marksInWords && c.isMark())) {
+                cls = WordCharacter;
+
+                if (c.isNumber()) {
+                    cls |= NumberCharacter;
+                } else if (c.isLower()) {
+                    cls |= LowercaseCharacter;
+                }
+            } else if (c.isSpace()) {
+                cls = SpaceCharacter;
+            }
+        }
+
+        if (cls & WordCharacter) {
+            if (!inWord) {
+                word.position = i;
+                inWord = true;
+            }
+
+            separatorCount = 0;
+            word.length++;
+            word.hasLowercase = word.hasLowercase || (cls & LowercaseCharacter);
+            word.hasNumber = word.hasNumber || (cls & NumberCharacter);
+
+#ifdef __SSE2__
+            // Skip ahead through runs of ASCII letters and digits.
+            while ((i + 9) <= length) {
+                int run = asciiWordRun(chars + i + 1, word.hasLowercase, word.hasNumber);
+
+                if (0 == run) {
+                    break;
+                }
+
+                i += run;
+                word.length += run;
+            }
+#endif
+        } else if ((cls & SpaceCharacter) && inWord) {
+            if (separatorCount > 0) {
+                word.length--;
+            }
+
+            position = i + 1;
+            return true;
+        } else {
+            // This is to handle things like double dashes (`--`)
+            // that separate words, while still counting hyphenated
+            // words as a single word.
+            //
+            separatorCount++;
+
+            if (inWord) {
+                if
+                (
+                    (1 == separatorCount)
+                    && !intraWordSeparators.isEmpty()
+                    && !intraWordSeparators.contains(QChar(ucs))
+                ) {
+                    position = i + 1;
+                    return true;
+                } else if (separatorCount > 1) {
+                    word.length--;
+                    position = i + 1;
+                    return true;
+                } else {
+                    word.length++;
+                }
+            }
+        }
+    }
+
+    position = length;
+
+    if (inWord) {
+        if (separatorCount > 0) {
+            word.length--;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+void WordSegmenter::countWords
+(
+    const QString &text,
+    int &words,
+    int &longWords,
+    int &wordCharacters
+) const
+{
+    WordSpan word;
+    int position = 0;
+
+    words = 0;
+    longWords = 0;
+    wordCharacters = 0;
+
+    while (nextWord(text, position, word)) {
+        words++;
+        wordCharacters += word.length;
+
+        if (word.length > 6) {
+            longWords++;
+        }
+    }
+}
+} // namespace ghostwriter
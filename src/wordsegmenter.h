@@ -0,0 +1,88 @@
+/***********************************************************************
+ *
+ * Copyright (C) 2014-2020 wereturtle
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ ***********************************************************************/
+
+
+#ifndef WORD_SEGMENTER_H
+#define WORD_SEGMENTER_H
+
+#include <QString>
+
+namespace ghostwriter
+{
+/**
+ * Splits text into words the way ghostwriter counts them, for use by both
+ * the document statistics and spell checking.  A single separator character
+ * (such as a hyphen) between letters joins them into one word, whereas
+ * whitespace or two separators in a row end the word.  Runs of ASCII text
+ * are classified without Unicode table lookups.
+ */
+class WordSegmenter
+{
+public:
+    /**
+     * A word found in the text, along with whether it contains lowercase
+     * letters or numbers.  Its length excludes any trailing separator.
+     */
+    struct WordSpan
+    {
+        int position;
+        int length;
+        bool hasLowercase;
+        bool hasNumber;
+    };
+
+    /**
+     * Constructor.  If intraWordSeparators is empty, any separator
+     * character can join letters into a single word.  Otherwise, only the
+     * given characters can, and any other separator ends the word.  If
+     * marksInWords is true, Unicode combining marks count as letters.
+     */
+    WordSegmenter
+    (
+        const QString &intraWordSeparators = QString(),
+        bool marksInWords = false
+    );
+
+    /**
+     * Finds the next word in the text, starting at the given position.
+     * Returns true and sets position to where the search for the following
+     * word should resume if a word was found, or false otherwise.
+     */
+    bool nextWord(const QString &text, int &position, WordSpan &word) const;
+
+    /**
+     * Counts the words in the text, the long words (of more than six
+     * characters, as used by the LIX readability formula), and the total
+     * number of characters within words, all in one pass.
+     */
+    void countWords
+    (
+        const QString &text,
+        int &words,
+        int &longWords,
+        int &wordCharacters
+    ) const;
+
+private:
+    QString intraWordSeparators;
+    bool marksInWords;
+};
+} // namespace ghostwriter
+
+#endif